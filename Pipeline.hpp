@@ -0,0 +1,335 @@
+/**
+ * @file     Pipeline.hpp
+ * @brief    流水线执行器(预处理/推理/后处理重叠执行)
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#if !defined(__PIPELINE_HPP__)
+#define __PIPELINE_HPP__
+#include "Ratiocinate.hpp"
+#include "Tools.Thread.hpp"
+
+namespace AIMethod {
+    /**
+     * @brief    流水线执行器
+     * @note     预处理、推理、后处理各自在独立线程中运行，阶段间使用有界队列，
+     *           第N+1帧预处理时第N帧推理、第N-1帧后处理；
+     *           推理阶段使用任务完成回调(不影响推理接口的回调)，同时最多 inflight 个推理任务，
+     *           完成的任务按提交顺序进入后处理；
+     *           预处理和后处理都是单线程时帧顺序不变
+     * @tparam T 帧(需可默认构造和移动)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    template<typename T>
+    class Pipeline {
+    public:
+        /**
+         * @brief    预处理
+         * @param    frame          帧
+         * @param    inputs         [out]推理输入(与绑定的输入一一对应)
+         * @return   std::string    错误信息(失败的帧跳过推理，直接进入后处理)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef std::function<std::string(T &frame, std::vector<IRatiocinate::Input> &inputs)> Preprocess_t;
+
+        /**
+         * @brief    后处理
+         * @param    frame          帧
+         * @param    outputs        推理输出
+         * @param    err            错误信息(预处理或推理失败)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef std::function<void(T &frame, const std::vector<IRatiocinate::Result> &outputs, const std::string &err)> Postprocess_t;
+
+        /**
+         * @brief    参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            size_t queue_size   = 2;   // 阶段间队列容量
+            int    pre_threads  = 1;   // 预处理线程数
+            int    post_threads = 1;   // 后处理线程数
+            int    inflight     = 1;   // 同时执行的推理任务数(大于1时需同时设置推理接口的 Scheduling::max_inflight)
+        } Parameters;
+
+        /**
+         * @brief    耗时统计(纳秒)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            Tools::Histogram::Summary pre;     // 预处理
+            Tools::Histogram::Summary infer;   // 推理(提交->回调)
+            Tools::Histogram::Summary post;    // 后处理
+            Tools::Histogram::Summary total;   // 入队->后处理完成(throughput即帧率)
+        } Statistics;
+
+    private:
+        class Item {
+        public:
+            T                                 frame;
+            std::vector<IRatiocinate::Input>  inputs;
+            std::vector<IRatiocinate::Result> outputs;
+            std::string                       err;
+            uint64_t                          push_ns = 0;
+        };
+
+        typedef struct
+        {
+            Item     item;
+            uint64_t start_ns = 0;       // 提交时间(0:未提交推理)
+            bool     done     = false;   // 已完成
+        } Task;
+
+        IRatiocinate         *infer;
+        IRatiocinate::Binding binding;
+        Preprocess_t          pre;
+        Postprocess_t         post;
+
+        Tools::BlockingQueue<Item> pre_queue;
+        Tools::BlockingQueue<Item> infer_queue;
+        Tools::BlockingQueue<Item> post_queue;
+        std::vector<std::thread>   pre_workers;
+        std::vector<std::thread>   post_workers;
+        std::thread                infer_worker;
+        std::thread                collect_worker;
+        std::atomic<int>           pre_alive;
+
+        // 推理中的任务(按提交顺序)
+        std::mutex                        mutex;
+        std::condition_variable           cond;
+        std::deque<std::shared_ptr<Task>> flight;
+        size_t                            inflight;
+        bool                              submit_end = false;
+
+        Tools::Histogram stat_pre;
+        Tools::Histogram stat_infer;
+        Tools::Histogram stat_post;
+        Tools::Histogram stat_total;
+
+        void RunPre()
+        {
+            Item item;
+            while (this->pre_queue.Pop(item)) {
+                auto start = Tools::GetNanosecond();
+                item.err   = this->pre(item.frame, item.inputs);
+                this->stat_pre.Record(Tools::GetNanosecond() - start);
+                if (!this->infer_queue.Push($(item)))
+                    break;
+            }
+            // 最后一个预处理线程退出后不再有推理任务
+            if (this->pre_alive.fetch_sub(1) == 1)
+                this->infer_queue.Close();
+            return;
+        }
+
+        void RunInfer()
+        {
+            Item item;
+            while (this->infer_queue.Pop(item)) {
+                auto task  = std::make_shared<Task>();
+                task->item = $(item);
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->cond.wait(lock, [this] { return this->flight.size() < this->inflight; });
+                    this->flight.push_back(task);
+                }
+                if (!task->item.err.empty()) {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    task->done = true;
+                    this->cond.notify_all();
+                    continue;
+                }
+                // 提交失败时也会调用完成回调，统一等待
+                IRatiocinate::ExecOptions options;
+                options.done = [this, task](const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    task->item.outputs = outputs;
+                    task->item.err     = err;
+                    task->done         = true;
+                    this->cond.notify_all();
+                };
+                task->start_ns = Tools::GetNanosecond();
+                this->infer->ExecAsync(this->binding, task->item.inputs, options);
+            }
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->submit_end = true;
+            }
+            this->cond.notify_all();
+            return;
+        }
+
+        void RunCollect()
+        {
+            while (true) {
+                std::shared_ptr<Task> task;
+                {
+                    // 按提交顺序取出完成的任务
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->cond.wait(lock, [this] {
+                        return this->flight.empty() ? this->submit_end : this->flight.front()->done;
+                    });
+                    if (this->flight.empty())
+                        break;
+                    task = $(this->flight.front());
+                    this->flight.pop_front();
+                }
+                this->cond.notify_all();   // 空出推理名额
+                if (task->start_ns != 0)
+                    this->stat_infer.Record(Tools::GetNanosecond() - task->start_ns);
+                task->item.inputs.clear();
+                this->post_queue.Push($(task->item));
+            }
+            this->post_queue.Close();
+            return;
+        }
+
+        void RunPost()
+        {
+            Item item;
+            while (this->post_queue.Pop(item)) {
+                auto start = Tools::GetNanosecond();
+                this->post(item.frame, item.outputs, item.err);
+                auto end = Tools::GetNanosecond();
+                this->stat_post.Record(end - start);
+                this->stat_total.Record(end - item.push_ns);
+                item.outputs.clear();
+            }
+            return;
+        }
+
+    public:
+        /**
+         * @brief    创建流水线
+         * @param    infer          推理接口(已加载模型)
+         * @param    binding        执行绑定
+         * @param    pre            预处理
+         * @param    post           后处理
+         * @param    params         参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        Pipeline(IRatiocinate                *infer,
+                 const IRatiocinate::Binding &binding,
+                 Preprocess_t                 pre,
+                 Postprocess_t                post,
+                 const Parameters            &params) :
+            infer(infer),
+            binding(binding),
+            pre($(pre)),
+            post($(post)),
+            pre_queue(params.queue_size),
+            infer_queue(params.queue_size),
+            post_queue(params.queue_size),
+            pre_alive(params.pre_threads < 1 ? 1 : params.pre_threads),
+            inflight(params.inflight < 1 ? 1 : params.inflight)
+        {
+            for (int i = 0; i < this->pre_alive.load(); i++)
+                this->pre_workers.push_back(std::thread(&Pipeline::RunPre, this));
+            this->infer_worker   = std::thread(&Pipeline::RunInfer, this);
+            this->collect_worker = std::thread(&Pipeline::RunCollect, this);
+            for (int i = 0; i < (params.post_threads < 1 ? 1 : params.post_threads); i++)
+                this->post_workers.push_back(std::thread(&Pipeline::RunPost, this));
+            return;
+        }
+
+        Pipeline(IRatiocinate *infer, const IRatiocinate::Binding &binding, Preprocess_t pre, Postprocess_t post) :
+            Pipeline(infer, binding, $(pre), $(post), Parameters()) {}
+
+        /**
+         * @brief    销毁(等待已提交的帧处理完成)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual ~Pipeline()
+        {
+            this->Wait();
+            return;
+        }
+
+        Pipeline(const Pipeline &)            = delete;
+        Pipeline &operator=(const Pipeline &) = delete;
+
+        /**
+         * @brief    提交帧(预处理队列满时等待)
+         * @param    frame          帧
+         * @return   true           成功
+         * @return   false          已关闭
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool Push(T frame)
+        {
+            Item item;
+            item.frame   = $(frame);
+            item.push_ns = Tools::GetNanosecond();
+            return this->pre_queue.Push($(item));
+        }
+
+        /**
+         * @brief    关闭(不再接受新帧，已提交的帧继续处理)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Close()
+        {
+            this->pre_queue.Close();
+            return;
+        }
+
+        /**
+         * @brief    关闭并等待所有帧处理完成
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Wait()
+        {
+            this->Close();
+            for (auto &thr : this->pre_workers) {
+                if (thr.joinable()) thr.join();
+            }
+            if (this->infer_worker.joinable())
+                this->infer_worker.join();
+            if (this->collect_worker.joinable())
+                this->collect_worker.join();
+            for (auto &thr : this->post_workers) {
+                if (thr.joinable()) thr.join();
+            }
+            return;
+        }
+
+        /**
+         * @brief    获取耗时统计
+         * @return   Statistics
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        Statistics GetStatistics() const
+        {
+            Statistics rs;
+            rs.pre   = this->stat_pre.Snapshot();
+            rs.infer = this->stat_infer.Snapshot();
+            rs.post  = this->stat_post.Snapshot();
+            rs.total = this->stat_total.Snapshot();
+            return rs;
+        }
+    };
+}   // namespace AIMethod
+
+#endif   // __PIPELINE_HPP__
@@ -39,6 +39,8 @@ namespace AIMethod {
             return std::vector<Result>();
         // 进行检测 xywh 置信度 类别
         std::vector<Result> result;
+        std::vector<float>  boxes;   // [n,4]   xyxy
+        std::vector<float>  kpts;    // [n,17,2]
         for (int i = 0; i < input.GetShape()[0]; i++) {
             Result rs;
             auto   data   = input.Value() + input.GetIdx(i, 0);
@@ -51,24 +53,27 @@ namespace AIMethod {
             float confidence = data[4];   // 置信度
             if (x1 < 0 || y1 < 0 || x2 < x1 || y2 < y1 || confidence < 0.5f)
                 continue;
-            cv::Rect r;
-            r.x      = x1;
-            r.y      = y1;
-            r.width  = x2 - x1;
-            r.height = y2 - y1;
-            rs.box   = let.Restore(r);
-            // 获取姿态信息
+            boxes.insert(boxes.end(), data, data + 4);
+            // 获取姿态信息(x,y,置信度)
             data += 6;
-            auto &pts         = rs.kpts;
-            auto &confidences = rs.confidences;
             for (size_t k = 0; k < 17; k++) {
-                pts[k].x       = data[k * 3 + 0];
-                pts[k].y       = data[k * 3 + 1];
-                pts[k]         = let.Restore(pts[k]);
-                confidences[k] = data[k * 3 + 2];
+                kpts.push_back(data[k * 3 + 0]);
+                kpts.push_back(data[k * 3 + 1]);
+                rs.confidences[k] = data[k * 3 + 2];
             }
             result.push_back(rs);
         }
+        // 批量还原坐标
+        let.RestoreBoxes(boxes.data(), result.size(), 4, Tools::Letterbox::BOX_XYXY, boxes.data());
+        let.RestorePoints(kpts.data(), result.size() * 17, 2, kpts.data());
+        for (size_t i = 0; i < result.size(); i++) {
+            auto  b  = boxes.data() + i * 4;
+            auto  p  = kpts.data() + i * 17 * 2;
+            auto &rs = result[i];
+            rs.box   = cv::Rect(cv::Point(b[0], b[1]), cv::Point(b[2], b[3]));
+            for (size_t k = 0; k < 17; k++)
+                rs.kpts[k] = cv::Point2i(p[k * 2 + 0], p[k * 2 + 1]);
+        }
         return result;
     }
 
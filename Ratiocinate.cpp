@@ -1,25 +1,413 @@
 
 #include "Ratiocinate.hpp"
+#include "Tools.Thread.hpp"
 #include <thread>
+#include <chrono>
+#include <memory>
+#include <condition_variable>
+#include <climits>
+#include <list>
+#include <set>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace AIMethod {
 
+    // --------------------------------------------------------------------------------
+    //                                调度
+    // --------------------------------------------------------------------------------
+
+    void IRatiocinate::SetScheduling(const Scheduling &scheduling, int def_inflight, int max_inflight)
+    {
+        std::lock_guard<std::mutex> lock(this->sched_mutex);
+        this->scheduling     = scheduling;
+        this->sched_inflight = scheduling.max_inflight <= 0 ? def_inflight : std::min(scheduling.max_inflight, max_inflight);
+        if (this->sched_inflight < 1)
+            this->sched_inflight = 1;
+        for (auto &weight : this->scheduling.weights) {
+            if (weight < 1) weight = 1;
+        }
+        return;
+    }
+
+    std::string IRatiocinate::Enqueue(IStatus *status)
+    {
+        std::vector<IStatus *> dropped;
+        {
+            std::lock_guard<std::mutex> lock(this->sched_mutex);
+            auto                        priority = status->priority;
+            auto                       &queue    = this->sched_queues[priority];
+            bool                        full     = this->scheduling.max_queue != 0 && queue.size() >= this->scheduling.max_queue;
+            switch (this->scheduling.overload) {
+                case OVERLOAD_DROP_NEWEST:
+                    if (full) {
+                        this->stat_dropped[priority].fetch_add(1);
+                        return ERR_RATIOCINATE_DROPPED;
+                    }
+                    break;
+                case OVERLOAD_DROP_OLDEST:
+                    if (full) {
+                        dropped.push_back(queue.front());
+                        queue.pop_front();
+                    }
+                    break;
+                case OVERLOAD_KEEP_LATEST:
+                    dropped.insert(dropped.end(), queue.begin(), queue.end());
+                    queue.clear();
+                    break;
+                case OVERLOAD_ADAPTIVE: {
+                    auto &skip = this->sched_skip[priority];
+                    auto &left = this->sched_skip_left[priority];
+                    if (left > 0) {
+                        left--;
+                        this->stat_dropped[priority].fetch_add(1);
+                        return ERR_RATIOCINATE_DROPPED;
+                    }
+                    // 上一个接收的任务仍在排队说明提交速度超过处理速度
+                    if (!queue.empty())
+                        skip = std::min(skip == 0 ? 1 : skip * 2, std::max(this->scheduling.max_skip, 0));
+                    else
+                        skip /= 2;
+                    left = skip;
+                    if (full) {
+                        dropped.push_back(queue.front());
+                        queue.pop_front();
+                    }
+                } break;
+            }
+            this->stat_dropped[priority].fetch_add(dropped.size());
+            // 空闲一段时间后重新排队的优先级不能累积配额
+            auto &vtime = this->sched_vtime[priority];
+            if (queue.empty() && vtime < this->sched_clock)
+                vtime = this->sched_clock;
+            queue.push_back(status);
+        }
+        for (auto item : dropped)
+            this->Drop(item, ERR_RATIOCINATE_DROPPED);
+        this->Schedule();
+        return std::string();
+    }
+
+    IRatiocinate::IStatus *IRatiocinate::Pick(bool run, std::vector<IStatus *> &dropped)
+    {
+        // 排队期间已取消或已超时的任务直接丢弃
+        for (auto &queue : this->sched_queues) {
+            for (auto it = queue.begin(); it != queue.end();) {
+                if ((*it)->cancel != nullptr && (*it)->cancel->Reason() != nullptr) {
+                    dropped.push_back(*it);
+                    it = queue.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (!run)
+            return nullptr;
+        int  best = -1;
+        auto now  = Tools::GetNanosecond();
+        // 防饥饿: 等待超时的优先级每个周期最多提前调度一次，避免积压的低优先级任务反过来饿死高优先级
+        if (this->scheduling.starvation_ns != 0) {
+            for (int i = 0; i < PRIORITY_COUNT; i++) {
+                auto &queue = this->sched_queues[i];
+                if (queue.empty() ||
+                    now - queue.front()->submit_ns < this->scheduling.starvation_ns ||
+                    now - this->sched_boost_ns[i] < this->scheduling.starvation_ns)
+                    continue;
+                if (best < 0 || queue.front()->submit_ns < this->sched_queues[best].front()->submit_ns)
+                    best = i;
+            }
+            if (best >= 0)
+                this->sched_boost_ns[best] = now;
+        }
+        // 加权公平: 虚拟时间最小的优先级(相同时高优先级优先)
+        if (best < 0) {
+            for (int i = 0; i < PRIORITY_COUNT; i++) {
+                if (!this->sched_queues[i].empty() && (best < 0 || this->sched_vtime[i] < this->sched_vtime[best]))
+                    best = i;
+            }
+        }
+        if (best < 0)
+            return nullptr;
+        auto status = this->sched_queues[best].front();
+        this->sched_queues[best].pop_front();
+        this->sched_clock = this->sched_vtime[best];
+        this->sched_vtime[best] += 1.0 / this->scheduling.weights[best];
+        return status;
+    }
+
+    void IRatiocinate::Schedule()
+    {
+        while (true) {
+            std::vector<IStatus *> dropped;
+            IStatus               *status = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(this->sched_mutex);
+                status = this->Pick(this->sched_running < this->sched_inflight, dropped);
+                if (status != nullptr)
+                    this->sched_running++;
+            }
+            for (auto item : dropped)
+                this->Drop(item, item->cancel->Reason());
+            if (status == nullptr)
+                return;
+            // 提交失败在本循环中回调，不经过Finish递归调度
+            auto err = this->Dispatch(status);
+            if (!err.empty()) {
+                {
+                    std::lock_guard<std::mutex> lock(this->sched_mutex);
+                    this->sched_running--;
+                }
+                this->Drop(status, err);
+            }
+        }
+    }
+
+    void IRatiocinate::Finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->sched_mutex);
+            this->sched_running--;
+        }
+        this->Schedule();
+        return;
+    }
+
+    void IRatiocinate::Drop(IStatus *status, const std::string &reason)
+    {
+        this->DisarmCancel(status);
+        this->Notify(status, std::vector<Result>(), reason);
+        delete status;
+        this->is_runing.fetch_sub(1);
+        return;
+    }
+
+    void IRatiocinate::DropQueued()
+    {
+        std::vector<IStatus *> dropped;
+        {
+            std::lock_guard<std::mutex> lock(this->sched_mutex);
+            for (auto &queue : this->sched_queues) {
+                dropped.insert(dropped.end(), queue.begin(), queue.end());
+                queue.clear();
+            }
+        }
+        for (auto item : dropped)
+            this->Drop(item, ERR_RATIOCINATE_CANCELED);
+        return;
+    }
+
+    void IRatiocinate::DropExpired()
+    {
+        std::vector<IStatus *> dropped;
+        {
+            std::lock_guard<std::mutex> lock(this->sched_mutex);
+            this->Pick(false, dropped);
+        }
+        for (auto item : dropped)
+            this->Drop(item, item->cancel->Reason());
+        return;
+    }
+
+    void IRatiocinate::WaitIdle()
+    {
+        while (this->is_runing.load() != 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return;
+    }
+
+    // --------------------------------------------------------------------------------
+    //                                输入缓冲环
+    // --------------------------------------------------------------------------------
+
+    IRatiocinate::InputRing::State::~State()
+    {
+        for (auto slot : this->slots) {
+            munlock(slot, this->bytes);
+            free(slot);
+        }
+        return;
+    }
+
+    void IRatiocinate::InputRing::State::Release(void *slot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->idle.push_back(slot);
+        }
+        this->cond.notify_one();
+        return;
+    }
+
+    IRatiocinate::InputRing::InputRing(const std::vector<int> &shape, size_t bytes, int count) :
+        state(std::make_shared<State>()), shape(shape), bytes(bytes)
+    {
+        this->size = 1;
+        for (auto v : shape)
+            this->size *= v;
+        // 按页对齐，预先写入(完成缺页)并尽量锁定，避免推理时缺页或被换出(锁定失败不影响使用)
+        size_t page        = sysconf(_SC_PAGESIZE);
+        this->state->bytes = (bytes + page - 1) / page * page;
+        for (int i = 0; i < count; i++) {
+            void *slot = nullptr;
+            if (posix_memalign(&slot, page, this->state->bytes) != 0)
+                RUN_ERR("Failed to allocate the input ring");
+            memset(slot, 0, this->state->bytes);
+            mlock(slot, this->state->bytes);
+            this->state->slots.push_back(slot);
+            this->state->idle.push_back(slot);
+        }
+        return;
+    }
+
+    void *IRatiocinate::InputRing::Pop(bool wait)
+    {
+        std::unique_lock<std::mutex> lock(this->state->mutex);
+        if (wait)
+            this->state->cond.wait(lock, [this] { return !this->state->idle.empty(); });
+        if (this->state->idle.empty())
+            return nullptr;
+        void *slot = this->state->idle.back();
+        this->state->idle.pop_back();
+        return slot;
+    }
+
+    size_t IRatiocinate::InputRing::Idle() const
+    {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        return this->state->idle.size();
+    }
+
+    std::string IRatiocinate::CreateInputRing(const Binding              &binding,
+                                              size_t                      index,
+                                              int                         count,
+                                              std::shared_ptr<InputRing> &ring,
+                                              Input::Type                 type)
+    {
+        static const size_t elem_size[] = {sizeof(float), sizeof(uint8_t), sizeof(int64_t), sizeof(Float16)};
+        if (binding == nullptr || index >= binding->input_names.size())
+            return "Invalid input index";
+        if (binding->sizes[index] == 0)
+            return "The input shape must be fixed";
+        if (count < 1 || type < Input::TYPE_FLOAT || type > Input::TYPE_FLOAT16)
+            return "Invalid parameter";
+        try {
+            ring = std::make_shared<InputRing>(binding->shapes[index], binding->sizes[index] * elem_size[type], count);
+        }
+        catch (std::exception &e) {
+            return e.what();
+        }
+        return std::string();
+    }
+
 #if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
 #include "onnxruntime_cxx_api.h"
+    /**
+     * @brief    运行环境(可由多个模型共享)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class Environment {
+    public:
+        Ort::Env   env;
+        bool       global_threads = false;   // 使用全局线程池
+        bool       allocator      = false;   // 已注册环境分配器
+        std::mutex mutex;
+
+        Environment() {}
+
+        Environment(const OrtThreadingOptions *threading) :
+            env(threading, ORT_LOGGING_LEVEL_WARNING, "AIMethod"), global_threads(true) {}
+    };
+
     class Ratiocinate : public IRatiocinate {
     private:
-        Ort::Session   *session = nullptr;
-        Ort::Env        env;
-        Ort::MemoryInfo memory{nullptr};
+        Ort::Session                *session = nullptr;
+        std::shared_ptr<Environment> env;
+        Ort::MemoryInfo              memory{nullptr};
+
+        std::vector<std::string>              model_inputs;    // 模型输入名称
+        std::vector<std::string>              model_outputs;   // 模型输出名称
+        std::vector<std::vector<int64_t>>     model_shapes;    // 模型输入形状
+        std::vector<Input::Type>              model_types;     // 模型输入元素类型
+        std::vector<bool>                     model_support;   // 模型输入元素类型是否支持(不支持的输入只能不绑定)
+        std::vector<std::vector<std::string>> model_dims;      // 模型输入各维度名称(未命名为空)
+
+        // 形状特化会话(按未覆盖的命名动态维度的取值区分)
+        typedef std::pair<std::vector<int64_t>, std::shared_ptr<Ort::Session>> ShapeSession;
+
+        Parameters                     load_params;               // 加载参数(不含模型数据)
+        std::string                    model_path;                // 模型文件
+        std::vector<uint8_t>           model_bytes;               // 模型数据(从内存加载时保留副本)
+        std::map<std::string, size_t>  shape_dims;                // 特化维度名称->特化键中的位置
+        std::mutex                     shape_mutex;
+        std::list<ShapeSession>        shape_cache;               // 最近使用的在前(会话为空表示创建失败)
+        std::set<std::vector<int64_t>> shape_pending;             // 正在创建
+        Tools::ThreadPool             *shape_builder = nullptr;   // 后台创建特化会话
+
+        class ExecBinding : public IBinding {
+        public:
+            std::vector<const char *>         _input_names;
+            std::vector<const char *>         _output_names;
+            std::vector<std::vector<int64_t>> _shapes;
+            std::vector<Input::Type>          _types;
+            std::vector<size_t>               _index;   // 模型输入序号
+        };
 
         class Status : public IStatus {
         public:
-            std::vector<Ort::Value>   input_values;
-            std::vector<Ort::Value>   output_values;
-            std::vector<const char *> _input_names;
-            std::vector<const char *> _output_names;
+            Ort::RunOptions               run_options;   // 每个任务独立，用于终止执行
+            std::vector<Ort::Value>       input_values;
+            std::vector<Ort::Value>       output_values;
+            Ort::Session                 *session = nullptr;   // 执行会话
+            std::shared_ptr<Ort::Session> specialized;         // 特化会话(执行期间保持，结束后在shape_builder释放)
         };
 
+        /**
+         * @brief    输出转换为推理结果
+         * @note     float输出直接接管(最后一个引用释放时才释放ORT内存)，其他数值类型转换为float
+         * @param    value          输出
+         * @return   Result
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static Result ToResult(Ort::Value &&value)
+        {
+            auto             info  = value.GetTensorTypeAndShapeInfo();
+            auto             shape = info.GetShape();
+            auto             size  = info.GetElementCount();
+            std::vector<int> _shape(shape.begin(), shape.end());
+            switch (info.GetElementType()) {
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT: {
+                    auto v = new Ort::Value($(value));
+                    return Result::MakeExternal(_shape, v->GetTensorMutableData<float>(), [v] { delete v; });
+                }
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8: return Convert(_shape, value.GetTensorData<uint8_t>(), size);
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8: return Convert(_shape, value.GetTensorData<int8_t>(), size);
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32: return Convert(_shape, value.GetTensorData<int32_t>(), size);
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64: return Convert(_shape, value.GetTensorData<int64_t>(), size);
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE: return Convert(_shape, value.GetTensorData<double>(), size);
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL: return Convert(_shape, value.GetTensorData<bool>(), size);
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16: {
+                    auto               p = (const uint16_t *)value.GetTensorRawData();
+                    std::vector<float> data(size);
+                    for (size_t i = 0; i < size; i++)
+                        data[i] = Float16::ToFloat(p[i]);
+                    return Result(_shape, $(data));
+                }
+                default: RUN_ERR("Unsupported output type");
+            }
+            return Result();
+        }
+
+        template<typename T>
+        static Result Convert(const std::vector<int> &shape, const T *p, size_t size)
+        {
+            std::vector<float> data(p, p + size);
+            return Result(shape, $(data));
+        }
+
         static void RunAsyncCallbackFn(void        *user_data,
                                        OrtValue   **outputs,
                                        size_t       num_outputs,
@@ -28,134 +416,691 @@ namespace AIMethod {
             Status      *sta   = static_cast<Status *>(user_data);
             Ratiocinate *infer = dynamic_cast<Ratiocinate *>(sta->infer);
             Ort::Status  status(status_ptr);
-            infer->is_runing.fetch_sub(1);
-            if (infer->callback != nullptr) {
+            infer->RecordRun(sta);
+            infer->DisarmCancel(sta);
+            // 先调度下一个任务，再执行回调(设置了完成回调执行器时回调不占用ORT线程)
+            infer->Finish();
+            if (infer->NeedNotify(sta)) {
                 std::vector<Result> result;
+                std::string         err;
                 if (status.IsOK()) {
-                    for (size_t i = 0; i < sta->output_names.size(); i++) {
-                        auto             data  = sta->output_values[i].GetTensorMutableData<float>();
-                        auto             shape = sta->output_values[i].GetTensorTypeAndShapeInfo().GetShape();
-                        Result           rs;
-                        std::vector<int> _shape(shape.size());
-                        for (size_t j = 0; j < shape.size(); j++)
-                            _shape[j] = shape[j];
-                        rs.shape = std::move(_shape);
-                        rs.data  = data;
-                        result.push_back(std::move(rs));
+                    try {
+                        for (size_t i = 0; i < sta->output_values.size(); i++)
+                            result.push_back(ToResult($(sta->output_values[i])));
+                    }
+                    catch (std::exception &e) {
+                        result.clear();
+                        err = e.what();
                     }
-                    infer->callback(infer,
-                                    sta->input_names,
-                                    sta->input_datas,
-                                    sta->output_names,
-                                    result,
-                                    infer->callback_context,
-                                    std::string());
                 } else {
-                    infer->callback(infer,
-                                    sta->input_names,
-                                    sta->input_datas,
-                                    sta->output_names,
-                                    result,
-                                    infer->callback_context,
-                                    status.GetErrorMessage());
+                    // 被终止时报告取消/超时
+                    auto reason = sta->cancel != nullptr ? sta->cancel->Reason() : nullptr;
+                    err         = reason != nullptr ? std::string(reason) : status.GetErrorMessage();
                 }
+                infer->Notify(sta, $(result), err);
             }
+            // 特化会话可能已被淘汰，此处是最后一个引用；当前是该会话的ORT线程，
+            // 不能在此析构(会等待自身线程池)，交给后台线程释放
+            if (sta->specialized != nullptr)
+                infer->shape_builder->Post([session = $(sta->specialized)]() mutable { session.reset(); });
             delete sta;
+            // 最后减少计数，销毁时据此等待回调结束
+            infer->is_runing.fetch_sub(1);
             return;
         }
 
     public:
+        Ratiocinate() :
+            env(std::make_shared<Environment>()) {}
+
+        Ratiocinate(const std::shared_ptr<Environment> &env) :
+            env(env) {}
+
         virtual ~Ratiocinate()
         {
+            this->DropQueued();
+            this->WaitIdle();
+            // 等待后台创建结束
+            if (this->shape_builder != nullptr)
+                delete this->shape_builder;
+            this->shape_cache.clear();
             if (this->session != nullptr)
                 delete this->session;
             return;
         }
 
-        virtual std::string LoadModel(const Parameters &params) override
+        /**
+         * @brief    优化模型缓存路径(模型哈希+ORT版本+优化级别)
+         * @param    params         模型参数
+         * @return   std::string    为空表示模型不可读
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static std::string CachePath(const Parameters &params)
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ULL;
+            if (params.model_data != nullptr) {
+                auto p = (const uint8_t *)params.model_data;
+                for (size_t i = 0; i < params.model_size; i++)
+                    hash = (hash ^ p[i]) * 1099511628211ULL;
+            } else {
+                FILE *fp = fopen(params.model, "rb");
+                if (fp == nullptr)
+                    return std::string();
+                uint8_t tmp[4096];
+                size_t  rs;
+                while ((rs = fread(tmp, 1, sizeof(tmp), fp)) > 0) {
+                    for (size_t i = 0; i < rs; i++)
+                        hash = (hash ^ tmp[i]) * 1099511628211ULL;
+                }
+                fclose(fp);
+            }
+            // 维度覆盖改变优化结果
+            for (auto &dims : {&params.free_dims, &params.free_dims_denotation}) {
+                for (auto &it : *dims) {
+                    auto str = Tools::Format("{0}={1};", it.first, it.second);
+                    for (auto c : str)
+                        hash = (hash ^ (uint8_t)c) * 1099511628211ULL;
+                }
+                hash = (hash ^ '|') * 1099511628211ULL;
+            }
+            std::string name = params.model == nullptr ? "model" : params.model;
+            auto        pos  = name.find_last_of('/');
+            if (pos != std::string::npos)
+                name = name.substr(pos + 1);
+            char str[64];
+            snprintf(str, sizeof(str), "%016llx", (unsigned long long)hash);
+            return Tools::Format("{0}/{1}.{2}.ort-{3}.ext.onnx", params.cache_dir, name, str, OrtGetApiBase()->GetVersionString());
+        }
+
+        /**
+         * @brief    读取模型输入输出信息
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string ReadMetadata()
+        {
+            Ort::AllocatorWithDefaultOptions allocator;
+            this->model_inputs.clear();
+            this->model_outputs.clear();
+            this->model_shapes.clear();
+            this->model_types.clear();
+            this->model_support.clear();
+            this->model_dims.clear();
+            this->shape_dims.clear();
+            try {
+                for (size_t i = 0; i < this->session->GetInputCount(); i++) {
+                    this->model_inputs.push_back(this->session->GetInputNameAllocated(i, allocator).get());
+                    auto info = this->session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo();
+                    this->model_shapes.push_back(info.GetShape());
+                    // 仍为动态的命名维度可按具体取值特化
+                    std::vector<std::string> dims;
+                    for (auto name : info.GetSymbolicDimensions())
+                        dims.push_back(name == nullptr ? "" : name);
+                    for (size_t j = 0; j < dims.size() && j < this->model_shapes.back().size(); j++) {
+                        if (this->model_shapes.back()[j] < 0 && !dims[j].empty() && this->shape_dims.count(dims[j]) == 0) {
+                            auto n                    = this->shape_dims.size();
+                            this->shape_dims[dims[j]] = n;
+                        }
+                    }
+                    this->model_dims.push_back($(dims));
+                    // 不支持的类型(如int32/bool)不影响加载，绑定该输入时才报错
+                    this->model_support.push_back(true);
+                    switch (info.GetElementType()) {
+                        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT: this->model_types.push_back(Input::TYPE_FLOAT); break;
+                        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8: this->model_types.push_back(Input::TYPE_UINT8); break;
+                        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64: this->model_types.push_back(Input::TYPE_INT64); break;
+                        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16: this->model_types.push_back(Input::TYPE_FLOAT16); break;
+                        default:
+                            this->model_types.push_back(Input::TYPE_FLOAT);
+                            this->model_support.back() = false;
+                            break;
+                    }
+                }
+                for (size_t i = 0; i < this->session->GetOutputCount(); i++)
+                    this->model_outputs.push_back(this->session->GetOutputNameAllocated(i, allocator).get());
+            }
+            catch (std::exception &e) {
+                return e.what();
+            }
+            return std::string();
+        }
+
+        /**
+         * @brief    预热(使用全零输入执行推理)
+         * @param    params         模型参数
+         * @param    session        会话
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static std::string WarmUp(const Parameters &params, Ort::Session *session)
+        {
+            Ort::AllocatorWithDefaultOptions allocator;
+            std::vector<Ort::AllocatedStringPtr> names;
+            std::vector<const char *>            input_names;
+            std::vector<const char *>            output_names;
+            std::vector<Ort::Value>              inputs;
+            size_t                               count = session->GetInputCount();
+            if (params.warmup_shapes.size() != 0 && params.warmup_shapes.size() != count)
+                return "The number of warm-up shapes does not match the model inputs";
+            try {
+                for (size_t i = 0; i < count; i++) {
+                    names.push_back(session->GetInputNameAllocated(i, allocator));
+                    input_names.push_back(names.back().get());
+                    auto info  = session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo();
+                    auto shape = info.GetShape();
+                    if (params.warmup_shapes.size() != 0)
+                        shape.assign(params.warmup_shapes[i].begin(), params.warmup_shapes[i].end());
+                    for (auto &v : shape) {
+                        if (v <= 0) v = 1;   // 动态维度
+                    }
+                    auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+                    // 输出内容不关心，仅对数值类型清零避免非法值
+                    if (info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING) {
+                        size_t bytes = value.GetTensorTypeAndShapeInfo().GetElementCount();
+                        switch (info.GetElementType()) {
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64: bytes *= 8; break;
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32: bytes *= 4; break;
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+                            case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16: bytes *= 2; break;
+                            default: break;
+                        }
+                        memset(value.GetTensorMutableRawData(), 0, bytes);
+                    }
+                    inputs.push_back(std::move(value));
+                }
+                for (size_t i = 0; i < session->GetOutputCount(); i++) {
+                    names.push_back(session->GetOutputNameAllocated(i, allocator));
+                    output_names.push_back(names.back().get());
+                }
+                for (int i = 0; i < params.warmup; i++)
+                    session->Run(Ort::RunOptions{nullptr},
+                                 input_names.data(),
+                                 inputs.data(),
+                                 inputs.size(),
+                                 output_names.data(),
+                                 output_names.size());
+            }
+            catch (std::exception &e) {
+                return e.what();
+            }
+            return std::string();
+        }
+
+        /**
+         * @brief    设置调优参数
+         * @param    params         模型参数
+         * @param    options        会话参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void SetTuning(const Parameters &params, Ort::SessionOptions &options)
+        {
+            auto &tuning = params.tuning;
+            options.SetExecutionMode(tuning.execution == EXEC_PARALLEL ? ExecutionMode::ORT_PARALLEL : ExecutionMode::ORT_SEQUENTIAL);
+            if (this->env->global_threads) {
+                // 线程相关参数由全局线程池决定
+                options.DisablePerSessionThreads();
+            } else {
+                // 设置线程数量
+                options.SetIntraOpNumThreads(params.threads);
+                options.SetInterOpNumThreads(tuning.inter_op_threads);
+                options.AddConfigEntry("session.intra_op.allow_spinning", tuning.allow_spinning ? "1" : "0");
+                options.AddConfigEntry("session.inter_op.allow_spinning", tuning.allow_spinning ? "1" : "0");
+                if (tuning.denormal_as_zero)
+                    options.AddConfigEntry("session.set_denormal_as_zero", "1");
+                if (!tuning.affinity.empty())
+                    options.AddConfigEntry("session.intra_op_thread_affinities", tuning.affinity.c_str());
+            }
+            if (!tuning.cpu_arena) {
+                options.DisableCpuMemArena();
+                return;
+            }
+            options.EnableCpuMemArena();
+            if (tuning.arena_extend != ARENA_NEXT_POWER_OF_TWO) {
+                // CPU内存池的扩展策略只能通过环境分配器设置(同一环境只注册一次)
+                std::lock_guard<std::mutex> lock(this->env->mutex);
+                if (!this->env->allocator) {
+                    Ort::ArenaCfg cfg(0, tuning.arena_extend, -1, -1);
+                    auto          info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+                    this->env->env.CreateAndRegisterAllocator(info, cfg);
+                    this->env->allocator = true;
+                }
+                options.AddConfigEntry("session.use_env_allocators", "1");
+            }
+            return;
+        }
+
+        /**
+         * @brief    设置动态维度覆盖
+         * @param    params         模型参数
+         * @param    options        会话参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static void SetFreeDims(const Parameters &params, Ort::SessionOptions &options)
+        {
+            for (auto &it : params.free_dims)
+                options.AddFreeDimensionOverrideByName(it.first.c_str(), it.second);
+            for (auto &it : params.free_dims_denotation)
+                options.AddFreeDimensionOverride(it.first.c_str(), it.second);
+            return;
+        }
+
+        /**
+         * @brief    计算特化键(特化维度的取值)
+         * @param    index          各输入的模型输入序号
+         * @param    shapes         各输入的形状
+         * @param    key            [out]特化键
+         * @return   true           所有特化维度都有取值
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool ShapeKey(const std::vector<size_t>                   &index,
+                      const std::vector<const std::vector<int> *> &shapes,
+                      std::vector<int64_t>                        &key) const
+        {
+            key.assign(this->shape_dims.size(), -1);
+            for (size_t i = 0; i < index.size(); i++) {
+                auto &dims  = this->model_dims[index[i]];
+                auto &shape = *shapes[i];
+                for (size_t j = 0; j < dims.size() && j < shape.size(); j++) {
+                    auto it = this->shape_dims.find(dims[j]);
+                    if (it == this->shape_dims.end())
+                        continue;
+                    // 同名维度取值不一致时无法特化
+                    if (key[it->second] >= 0 && key[it->second] != shape[j])
+                        return false;
+                    key[it->second] = shape[j];
+                }
+            }
+            for (auto v : key) {
+                if (v <= 0) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief    创建特化会话(特化维度按常量优化)
+         * @param    key            特化键
+         * @return   std::shared_ptr<Ort::Session>
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::shared_ptr<Ort::Session> CreateSession(const std::vector<int64_t> &key)
         {
             Ort::SessionOptions options;
-            // 设置线程数量
-            options.SetIntraOpNumThreads(params.threads);
-            // ORT_ENABLE_ALL: 启用所有可能的优化
+            SetTuning(this->load_params, options);
             options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+            SetFreeDims(this->load_params, options);
+            for (auto &it : this->shape_dims)
+                options.AddFreeDimensionOverrideByName(it.first.c_str(), key[it.second]);
+            if (!this->model_bytes.empty())
+                return std::make_shared<Ort::Session>(this->env->env, this->model_bytes.data(), this->model_bytes.size(), options);
+            return std::make_shared<Ort::Session>(this->env->env, this->model_path.c_str(), options);
+        }
+
+        /**
+         * @brief    加入特化会话缓存(超出数量时淘汰最久未使用的)
+         * @param    key            特化键
+         * @param    session        会话(为空表示创建失败，不再重试)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void CacheSession(const std::vector<int64_t> &key, std::shared_ptr<Ort::Session> session)
+        {
+            std::shared_ptr<Ort::Session> evict;   // 在锁外释放
+            std::lock_guard<std::mutex>   lock(this->shape_mutex);
+            this->shape_pending.erase(key);
+            this->shape_cache.push_front(ShapeSession(key, $(session)));
+            if (this->shape_cache.size() > (size_t)this->load_params.shape_sessions) {
+                evict = $(this->shape_cache.back().second);
+                this->shape_cache.pop_back();
+            }
+            return;
+        }
+
+        /**
+         * @brief    查找特化会话(未命中时在后台创建，本次使用通用会话)
+         * @param    key            特化键
+         * @return   std::shared_ptr<Ort::Session>  为空使用通用会话
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::shared_ptr<Ort::Session> FindSession(const std::vector<int64_t> &key)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->shape_mutex);
+                for (auto it = this->shape_cache.begin(); it != this->shape_cache.end(); ++it) {
+                    if (it->first != key)
+                        continue;
+                    if (it != this->shape_cache.begin())
+                        this->shape_cache.splice(this->shape_cache.begin(), this->shape_cache, it);
+                    return this->shape_cache.front().second;
+                }
+                if (this->shape_pending.count(key) != 0)
+                    return nullptr;
+                this->shape_pending.insert(key);
+            }
+            this->shape_builder->Post([this, key] {
+                std::shared_ptr<Ort::Session> session;
+                try {
+                    session = this->CreateSession(key);
+                }
+                catch (std::exception &) {
+                    session = nullptr;
+                }
+                this->CacheSession(key, $(session));
+            });
+            return nullptr;
+        }
+
+        /**
+         * @brief    初始化形状特化(保留模型用于创建特化会话，预热形状在加载时特化)
+         * @param    params         模型参数
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string InitShapeSessions(const Parameters &params)
+        {
+            this->load_params            = params;
+            this->load_params.model      = nullptr;
+            this->load_params.model_data = nullptr;
+            this->load_params.model_size = 0;
+            this->load_params.cache_dir  = nullptr;
+            this->load_params.warmup_shapes.clear();
+            if (params.model_data != nullptr)
+                this->model_bytes.assign((const uint8_t *)params.model_data, (const uint8_t *)params.model_data + params.model_size);
+            else
+                this->model_path = params.model;
+            if (params.warmup_shapes.size() == this->model_inputs.size()) {
+                std::vector<size_t>                   index;
+                std::vector<const std::vector<int> *> shapes;
+                std::vector<int64_t>                  key;
+                for (size_t i = 0; i < params.warmup_shapes.size(); i++) {
+                    index.push_back(i);
+                    shapes.push_back(&params.warmup_shapes[i]);
+                }
+                if (ShapeKey(index, shapes, key)) {
+                    try {
+                        auto session = this->CreateSession(key);
+                        if (params.warmup > 0) {
+                            auto err = WarmUp(params, session.get());
+                            if (!err.empty())
+                                return err;
+                        }
+                        this->CacheSession(key, $(session));
+                    }
+                    catch (std::exception &e) {
+                        return e.what();
+                    }
+                }
+            }
+            this->shape_builder = new Tools::ThreadPool(1);
+            return std::string();
+        }
+
+        virtual std::string LoadModel(const Parameters &params) override
+        {
+            Ort::SessionOptions options;
+            std::string         cache_path;
+            std::string         cache_tmp;
+            bool                from_cache = false;
+            auto                err        = Ratiocinate_CheckTuning(params);
+            if (!err.empty())
+                return err;
+            if (params.model == nullptr && params.model_data == nullptr)
+                return "The model cannot be empty";
+            // 会话支持并发执行，默认同时只执行一个任务
+            this->SetScheduling(params.scheduling, 1, INT_MAX);
+            this->completion_executor = params.executor;
             try {
-                this->session = new Ort::Session{this->env, params.model, options};
+                SetTuning(params, options);
+                SetFreeDims(params, options);
             }
             catch (std::exception &e) {
                 return e.what();
             }
+            // 优化模型缓存
+            if (params.cache_dir != nullptr && params.cache_dir[0] != '\0') {
+                cache_path = CachePath(params);
+                from_cache = !cache_path.empty() && access(cache_path.c_str(), R_OK) == 0;
+            }
+            if (!from_cache && !cache_path.empty()) {
+                // ORT_ENABLE_ALL 的布局优化与本机指令集相关，缓存只保存到 ORT_ENABLE_EXTENDED
+                // 先写临时文件，成功后再改名，避免多进程读到不完整的缓存
+                cache_tmp = Tools::Format("{0}.{1}.tmp", cache_path, getpid());
+                try {
+                    auto save = options.Clone();
+                    save.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+                    save.SetOptimizedModelFilePath(cache_tmp.c_str());
+                    // 临时会话只用于写出缓存
+                    if (params.model_data != nullptr)
+                        Ort::Session{this->env->env, params.model_data, params.model_size, save};
+                    else
+                        Ort::Session{this->env->env, params.model, save};
+                    from_cache = rename(cache_tmp.c_str(), cache_path.c_str()) == 0;
+                }
+                catch (std::exception &) {
+                    // 缓存失败不影响加载
+                }
+                if (!from_cache)
+                    remove(cache_tmp.c_str());
+            }
+            // ORT_ENABLE_ALL: 启用所有可能的优化(缓存只需补做本机相关的优化)
+            options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+            if (from_cache) {
+                try {
+                    this->session = new Ort::Session{this->env->env, cache_path.c_str(), options};
+                }
+                catch (std::exception &) {
+                    // 缓存损坏，删除后按原模型加载
+                    remove(cache_path.c_str());
+                    from_cache = false;
+                }
+            }
+            if (!from_cache) {
+                try {
+                    if (params.model_data != nullptr)
+                        this->session = new Ort::Session{this->env->env, params.model_data, params.model_size, options};
+                    else
+                        this->session = new Ort::Session{this->env->env, params.model, options};
+                }
+                catch (std::exception &e) {
+                    return e.what();
+                }
+            }
             if (this->session == nullptr)
                 return "Failed to create a session";
             // 创建内存分配器
             this->memory = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+            err          = ReadMetadata();
+            // 预热: 提前完成内存池增长和权重重排等一次性开销
+            if (err.empty() && params.warmup > 0)
+                err = WarmUp(params, this->session);
+            // 按具体形状特化
+            if (err.empty() && params.shape_sessions > 0 && !this->shape_dims.empty())
+                err = InitShapeSessions(params);
+            if (!err.empty()) {
+                // 加载失败不保留会话
+                this->shape_cache.clear();
+                delete this->session;
+                this->session = nullptr;
+            }
+            return err;
+        }
+
+        virtual std::string Prepare(const std::vector<std::string>      &input_names,
+                                    const std::vector<std::string>      &output_names,
+                                    const std::vector<std::vector<int>> &shapes,
+                                    Binding                             &binding) override
+        {
+            if (this->session == nullptr)
+                return "The model is not loaded";
+            auto bd  = std::make_shared<ExecBinding>();
+            auto err = InitBinding(*bd, input_names, output_names, shapes);
+            if (!err.empty())
+                return err;
+            // 按模型信息校验
+            for (size_t i = 0; i < input_names.size(); i++) {
+                auto it = std::find(this->model_inputs.begin(), this->model_inputs.end(), input_names[i]);
+                if (it == this->model_inputs.end())
+                    return Tools::Format("Unknown input: {0}", input_names[i]);
+                if (!this->model_support[it - this->model_inputs.begin()])
+                    return Tools::Format("Unsupported input type: {0}", input_names[i]);
+                bd->_types.push_back(this->model_types[it - this->model_inputs.begin()]);
+                bd->_index.push_back(it - this->model_inputs.begin());
+                if (shapes.size() == 0)
+                    continue;
+                auto &model = this->model_shapes[it - this->model_inputs.begin()];
+                if (model.size() != shapes[i].size())
+                    return Tools::Format("Input shape rank mismatch: {0}", input_names[i]);
+                for (size_t j = 0; j < model.size(); j++) {
+                    if (model[j] > 0 && shapes[i][j] != model[j])
+                        return Tools::Format("Input shape mismatch: {0}", input_names[i]);
+                }
+            }
+            for (auto &name : output_names) {
+                if (std::find(this->model_outputs.begin(), this->model_outputs.end(), name) == this->model_outputs.end())
+                    return Tools::Format("Unknown output: {0}", name);
+            }
+            for (auto &name : bd->input_names)
+                bd->_input_names.push_back(name.c_str());
+            for (auto &name : bd->output_names)
+                bd->_output_names.push_back(name.c_str());
+            for (auto &shape : bd->shapes)
+                bd->_shapes.push_back(std::vector<int64_t>(shape.begin(), shape.end()));
+            binding = bd;
             return std::string();
         }
 
-        std::string _ExecAsync(const std::vector<std::string>   &input_names,
-                               const std::vector<std::string>   &output_names,
-                               const std::vector<Tensor<float>> &input_datas)
+        std::string _ExecAsync(const Binding                    &binding,
+                               const std::vector<Input>         &input_datas,
+                               const ExecOptions                &options)
         {
-            if (input_names.size() == 0 || input_names.size() != input_datas.size() || output_names.size() == 0)
-                return "The input parameter cannot be empty";
+            if (binding == nullptr || input_datas.size() != binding->input_names.size())
+                return "The input does not match the binding";
+            if (options.priority < 0 || options.priority >= PRIORITY_COUNT)
+                return "Invalid priority";
+            auto        bd     = static_cast<const ExecBinding *>(binding.get());
             Status     *status = new Status();
             std::string err;
-            status->infer        = this;
-            status->input_datas  = input_datas;
-            status->input_names  = input_names;
-            status->output_names = output_names;
-            status->_input_names.resize(input_names.size());
-            status->_output_names.resize(output_names.size());
-            // 设置输入
-            for (size_t i = 0; i < status->input_names.size(); i++) {
-                auto shape  = input_datas[i].GetShape<int64_t>();
-                auto tensor = Ort::Value::CreateTensor<float>(this->memory,
-                                                              (float *)status->input_datas[i].Value(),
-                                                              status->input_datas[i].Size(),
-                                                              shape.data(),
-                                                              shape.size());
-                status->input_values.push_back(std::move(tensor));
-                status->_input_names[i] = status->input_names[i].c_str();
+            status->infer       = this;
+            status->submit_ns   = Tools::GetNanosecond();
+            status->binding     = binding;
+            status->input_datas = input_datas;
+            status->priority    = options.priority;
+            status->done        = options.done;
+            status->executor    = options.executor;
+            // 设置输入(形状固定时直接使用绑定的形状)
+            static const ONNXTensorElementDataType types[] = {ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT,
+                                                              ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8,
+                                                              ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64,
+                                                              ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16};
+            for (size_t i = 0; i < input_datas.size(); i++) {
+                auto &data = status->input_datas[i];
+                if (data.GetType() != bd->_types[i]) {
+                    delete status;
+                    return Tools::Format("Input type mismatch: {0}", bd->input_names[i]);
+                }
+                if (bd->sizes[i] != 0) {
+                    if (data.Size() != bd->sizes[i]) {
+                        delete status;
+                        return "The input does not match the binding";
+                    }
+                    status->input_values.push_back(Ort::Value::CreateTensor(this->memory,
+                                                                             (void *)data.Data(),
+                                                                             data.Bytes(),
+                                                                             bd->_shapes[i].data(),
+                                                                             bd->_shapes[i].size(),
+                                                                             types[data.GetType()]));
+                } else {
+                    auto &_shape = data.GetShape();
+                    auto  shape  = std::vector<int64_t>(_shape.begin(), _shape.end());
+                    status->input_values.push_back(Ort::Value::CreateTensor(this->memory,
+                                                                             (void *)data.Data(),
+                                                                             data.Bytes(),
+                                                                             shape.data(),
+                                                                             shape.size(),
+                                                                             types[data.GetType()]));
+                }
             }
             // 设置输出
-            for (size_t i = 0; i < status->output_names.size(); i++) {
-                status->output_values.push_back(std::move(Ort::Value{nullptr}));
-                status->_output_names[i] = status->output_names[i].c_str();
+            for (size_t i = 0; i < bd->_output_names.size(); i++)
+                status->output_values.push_back(Ort::Value{nullptr});
+            // 选择会话(已有特化会话时使用特化会话)
+            status->session = this->session;
+            if (this->shape_builder != nullptr) {
+                std::vector<const std::vector<int> *> shapes;
+                std::vector<int64_t>                  key;
+                for (auto &data : status->input_datas)
+                    shapes.push_back(&data.GetShape());
+                if (ShapeKey(bd->_index, shapes, key))
+                    status->specialized = this->FindSession(key);
+                if (status->specialized != nullptr)
+                    status->session = status->specialized.get();
             }
-            // 执行
-            try {
-                this->is_runing.fetch_add(1);
-                this->session->RunAsync(Ort::RunOptions{nullptr},
-                                        status->_input_names.data(),
-                                        status->input_values.data(),
-                                        status->input_values.size(),
-                                        status->_output_names.data(),
-                                        status->output_values.data(),
-                                        status->output_values.size(),
-                                        RunAsyncCallbackFn,
-                                        status);
+            // 已取消或已超时的任务不提交
+            err = this->ArmCancel(status, options);
+            if (!err.empty()) {
+                delete status;
+                return err;
             }
-            catch (std::exception &e) {
-                err = e.what();
+            // 排队等待调度
+            this->is_runing.fetch_add(1);
+            err = this->Enqueue(status);
+            if (!err.empty()) {
+                this->DisarmCancel(status);
                 this->is_runing.fetch_sub(1);
                 delete status;
             }
             return err;
         }
 
-        virtual std::string ExecAsync(const std::vector<std::string>   &input_name,
-                                      const std::vector<std::string>   &output_name,
-                                      const std::vector<Tensor<float>> &input_data) override
+        virtual std::string Dispatch(IStatus *s) override
         {
-            int flag = 0;
-            if (!this->is_runing.compare_exchange_strong(flag, 1))
-                return "A task is running";
-            auto ret = _ExecAsync(input_name, output_name, input_data);
-            if (!ret.empty() && this->callback != nullptr) {
-                const std::vector<Result> tmp;
-                this->callback(this, input_name, input_data, output_name, tmp, this->callback_context, ret);
+            auto status = static_cast<Status *>(s);
+            auto bd     = static_cast<const ExecBinding *>(status->binding.get());
+            // 取消/超时时终止执行
+            if (status->cancel != nullptr)
+                status->cancel->Attach([status] { status->run_options.SetTerminate(); });
+            try {
+                status->start_ns = Tools::GetNanosecond();
+                status->session->RunAsync(status->run_options,
+                                          bd->_input_names.data(),
+                                          status->input_values.data(),
+                                          status->input_values.size(),
+                                          bd->_output_names.data(),
+                                          status->output_values.data(),
+                                          status->output_values.size(),
+                                          RunAsyncCallbackFn,
+                                          status);
+            }
+            catch (std::exception &e) {
+                return e.what();
             }
-            this->is_runing.fetch_sub(1);
+            return std::string();
+        }
+
+        using IRatiocinate::ExecAsync;
+
+        virtual std::string ExecAsync(const Binding                    &binding,
+                                      const std::vector<Input>         &input_datas,
+                                      const ExecOptions                &options) override
+        {
+            auto ret = _ExecAsync(binding, input_datas, options);
+            if (!ret.empty())
+                this->Notify(binding, input_datas, std::vector<Result>(), ret, options.done, options.executor);
             return ret;
         }
 
@@ -168,120 +1113,235 @@ namespace AIMethod {
 #include <opencv4/opencv2/dnn.hpp>
     class Ratiocinate : public IRatiocinate {
     private:
-        cv::dnn::Net *session = nullptr;
+        std::vector<cv::dnn::Net *> nets;        // 每个工作线程一个网络
+        std::vector<cv::dnn::Net *> idle_nets;   // 空闲网络
+        std::mutex                  nets_mutex;
+        Tools::ThreadPool          *pool    = nullptr;
+        int                         workers = 1;
 
         class Status : public IStatus {};
 
+        void Release()
+        {
+            // 先停止线程池，等待正在执行的任务
+            if (this->pool != nullptr)
+                delete this->pool;
+            this->pool = nullptr;
+            for (auto net : this->nets)
+                delete net;
+            this->nets.clear();
+            this->idle_nets.clear();
+            return;
+        }
+
+        cv::dnn::Net *AcquireNet()
+        {
+            std::lock_guard<std::mutex> lock(this->nets_mutex);
+            if (this->idle_nets.empty())
+                return nullptr;
+            auto net = this->idle_nets.back();
+            this->idle_nets.pop_back();
+            return net;
+        }
+
+        void ReleaseNet(cv::dnn::Net *net)
+        {
+            std::lock_guard<std::mutex> lock(this->nets_mutex);
+            this->idle_nets.push_back(net);
+            return;
+        }
+
     public:
         virtual ~Ratiocinate()
         {
-            if (this->session != nullptr)
-                delete this->session;
+            this->DropQueued();
+            this->WaitIdle();
+            this->Release();
             return;
         }
 
         virtual std::string LoadModel(const Parameters &params) override
         {
+            this->Release();
+            this->workers = params.workers < 1 ? 1 : params.workers;
+            // 同时执行的任务数不超过网络数
+            this->SetScheduling(params.scheduling, this->workers, this->workers);
+            this->completion_executor = params.executor;
+            // 模型文件只读取一次，每个工作线程解析出独立的网络
+            if (params.model == nullptr)
+                return "The model cannot be empty";
+            std::vector<uchar> buffer;
+            FILE              *fp = fopen(params.model, "rb");
+            if (fp == nullptr)
+                return "Failed to open model file";
+            char   tmp[4096];
+            size_t rs;
+            while ((rs = fread(tmp, 1, sizeof(tmp), fp)) > 0)
+                buffer.insert(buffer.end(), tmp, tmp + rs);
+            fclose(fp);
             try {
-                this->session = new cv::dnn::Net(cv::dnn::readNetFromONNX(params.model));
-                this->session->setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-                this->session->setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+                for (int i = 0; i < this->workers; i++) {
+                    auto net = new cv::dnn::Net(cv::dnn::readNetFromONNX(buffer));
+                    this->nets.push_back(net);
+                    if (net->empty())
+                        break;
+                    net->setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+                    net->setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+                }
             }
-            catch (std::exception ex) {
+            catch (std::exception &ex) {
+                this->Release();
                 return ex.what();
             }
-            if (this->session == nullptr || this->session->empty())
+            if (this->nets.size() != (size_t)this->workers || this->nets.back()->empty()) {
+                this->Release();
                 return "Failed to create a session";
+            }
+            this->idle_nets = this->nets;
+            this->pool      = new Tools::ThreadPool(this->workers);
             return std::string();
         }
 
         static void exec(Status *status)
         {
             if (status == nullptr) return;
-            Ratiocinate               *infer        = dynamic_cast<Ratiocinate *>(status->infer);
-            auto                      &input_names  = status->input_names;
-            auto                      &input_datas  = status->input_datas;
-            auto                      &output_names = status->output_names;
-            std::string                err;
-            std::vector<Tensor<float>> output_datas;
+            Ratiocinate         *infer        = dynamic_cast<Ratiocinate *>(status->infer);
+            auto                &input_names  = status->binding->input_names;
+            auto                &input_datas  = status->input_datas;
+            auto                &output_names = status->binding->output_names;
+            std::string          err;
+            std::vector<cv::Mat> outs;
+            cv::dnn::Net        *net = nullptr;
+            status->start_ns         = Tools::GetNanosecond();
+            // 排队期间已取消或已超时的任务直接丢弃(执行中无法终止)
+            auto reason = status->cancel != nullptr ? status->cancel->Reason() : nullptr;
             try {
-                for (size_t i = 0; i < input_names.size(); i++) {
-                    auto    shape = input_datas[i].GetShape();
-                    cv::Mat input(shape, CV_32F);
-                    auto    s = input_datas[i].Size();
-                    memcpy(input.data, input_datas[i].Value(), s * sizeof(float));
-                    infer->session->setInput(input, input_names[i].c_str());
-                }
-
-                for (size_t i = 0; i < output_names.size(); i++) {
-                    auto             data = infer->session->forward(output_names[i].c_str());
-                    std::vector<int> shape(data.size.p, data.size.p + data.dims);
-                    output_datas.push_back(Tensor<float>(shape, (float *)data.data));
+                if (reason != nullptr) {
+                    err = reason;
+                } else {
+                    // 网络数与工作线程数相同，每个线程最多占用一个，必定有空闲网络
+                    net = infer->AcquireNet();
+                    if (net == nullptr)
+                        RUN_ERR("No idle network");
+                    for (size_t i = 0; i < input_names.size(); i++) {
+                        // 直接引用张量数据，不拷贝(uint8由网络转换为float，float16需先转换)
+                        auto   &data  = input_datas[i];
+                        auto   &shape = data.GetShape();
+                        int     type  = data.GetType() == Input::TYPE_UINT8 ? CV_8U : data.GetType() == Input::TYPE_FLOAT16 ? CV_16F : CV_32F;
+                        cv::Mat input((int)shape.size(), shape.data(), type, (void *)data.Data());
+                        if (type == CV_16F)
+                            input.convertTo(input, CV_32F);
+                        net->setInput(input, input_names[i]);
+                    }
+                    // 一次前向计算得到全部输出
+                    net->forward(outs, output_names);
                 }
             }
             catch (std::exception &ex) {
                 err = ex.what();
             }
-            infer->is_runing.fetch_sub(1);
-            if (infer->callback != nullptr) {
-                std::vector<Result> result;
-                for (size_t i = 0; i < output_datas.size(); i++) {
-                    Result rs;
-                    rs.shape = output_datas[i].GetShape();
-                    rs.data  = output_datas[i].Value();
-                    result.push_back(rs);
-                }
-                infer->callback(infer,
-                                input_names,
-                                input_datas,
-                                output_names,
-                                result,
-                                infer->callback_context,
-                                err);
+            infer->RecordRun(status);
+            infer->DisarmCancel(status);
+            std::vector<Result> result;
+            if (err.empty() && infer->NeedNotify(status)) {
+                // 输出内存由网络复用，需拷贝后才能在回调外使用
+                for (size_t i = 0; i < outs.size(); i++) {
+                    std::vector<int> shape(outs[i].size.p, outs[i].size.p + outs[i].dims);
+                    result.push_back(Result(shape, (const float *)outs[i].data));
+                }
             }
+            // 输出已拷贝，先归还网络并调度下一个任务，再执行回调
+            outs.clear();
+            if (net != nullptr)
+                infer->ReleaseNet(net);
+            infer->Finish();
+            infer->Notify(status, $(result), err);
             delete status;
+            // 最后减少计数，销毁时据此等待回调结束
+            infer->is_runing.fetch_sub(1);
             return;
         }
 
-        std::string _ExecAsync(const std::vector<std::string>   &input_names,
-                               const std::vector<std::string>   &output_names,
-                               const std::vector<Tensor<float>> &input_datas)
+        virtual std::string Prepare(const std::vector<std::string>      &input_names,
+                                    const std::vector<std::string>      &output_names,
+                                    const std::vector<std::vector<int>> &shapes,
+                                    Binding                             &binding) override
         {
-            if (input_names.size() == 0 || input_names.size() != input_datas.size() || output_names.size() == 0)
-                return "The input parameter cannot be empty";
+            if (this->pool == nullptr)
+                return "The model is not loaded";
+            auto bd  = std::make_shared<IBinding>();
+            auto err = InitBinding(*bd, input_names, output_names, shapes);
+            if (!err.empty())
+                return err;
+            // OpenCV 没有公开的输入名称查询接口，仅校验输出
+            for (auto &name : output_names) {
+                if (this->nets[0]->getLayerId(name) < 0)
+                    return Tools::Format("Unknown output: {0}", name);
+            }
+            binding = bd;
+            return std::string();
+        }
 
-            Status *status       = new Status();
-            status->infer        = this;
-            status->input_datas  = input_datas;
-            status->input_names  = input_names;
-            status->output_names = output_names;
+        std::string _ExecAsync(const Binding                    &binding,
+                               const std::vector<Input>         &input_datas,
+                               const ExecOptions                &options)
+        {
+            if (this->pool == nullptr)
+                return "The model is not loaded";
+            if (binding == nullptr || input_datas.size() != binding->input_names.size())
+                return "The input does not match the binding";
+            for (size_t i = 0; i < input_datas.size(); i++) {
+                if (binding->sizes[i] != 0 && input_datas[i].Size() != binding->sizes[i])
+                    return "The input does not match the binding";
+                if (input_datas[i].GetType() == Input::TYPE_INT64)
+                    return Tools::Format("Unsupported input type: {0}", binding->input_names[i]);
+            }
 
-            try {
-                this->is_runing.fetch_add(1);
-                std::thread thr(exec, status);
-                thr.detach();   // 分离线程
+            if (options.priority < 0 || options.priority >= PRIORITY_COUNT)
+                return "Invalid priority";
+
+            Status *status    = new Status();
+            status->infer     = this;
+            status->submit_ns = Tools::GetNanosecond();
+            auto err          = this->ArmCancel(status, options);
+            if (!err.empty()) {
+                delete status;
+                return err;
             }
-            catch (std::exception &ex) {
-                this->is_runing.fetch_sub(0);
+            status->binding     = binding;
+            status->input_datas = input_datas;
+            status->priority    = options.priority;
+            status->done        = options.done;
+            status->executor    = options.executor;
+
+            // 排队等待调度
+            this->is_runing.fetch_add(1);
+            err = this->Enqueue(status);
+            if (!err.empty()) {
+                this->DisarmCancel(status);
+                this->is_runing.fetch_sub(1);
                 delete status;
-                return ex.what();
             }
+            return err;
+        }
+
+        virtual std::string Dispatch(IStatus *s) override
+        {
+            auto status = static_cast<Status *>(s);
+            if (!this->pool->Post(std::bind(exec, status)))
+                return "Failed to submit task";
             return std::string();
         }
 
-        virtual std::string ExecAsync(const std::vector<std::string>   &input_name,
-                                      const std::vector<std::string>   &output_name,
-                                      const std::vector<Tensor<float>> &input_data) override
+        using IRatiocinate::ExecAsync;
+
+        virtual std::string ExecAsync(const Binding                    &binding,
+                                      const std::vector<Input>         &input_datas,
+                                      const ExecOptions                &options) override
         {
-            int flag = 0;
-            if (!this->is_runing.compare_exchange_strong(flag, 1))
-                return "A task is running";
-            auto ret = _ExecAsync(input_name, output_name, input_data);
-            if (!ret.empty() && this->callback != nullptr) {
-                const std::vector<Result> tmp;
-                this->callback(this, input_name, input_data, output_name, tmp, this->callback_context, ret);
-            }
-            this->is_runing.fetch_sub(1);
+            auto ret = _ExecAsync(binding, input_datas, options);
+            if (!ret.empty())
+                this->Notify(binding, input_datas, std::vector<Result>(), ret, options.done, options.executor);
             return ret;
         }
 
@@ -296,4 +1356,395 @@ namespace AIMethod {
     {
         return new Ratiocinate();
     }
+
+#if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
+    /**
+     * @brief    只读内存映射文件
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class MappedFile {
+    public:
+        void  *data = nullptr;
+        size_t size = 0;
+
+        std::string Open(const char *path)
+        {
+            int fd = open(path, O_RDONLY);
+            if (fd < 0)
+                return Tools::Format("Failed to open {0}", path);
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size == 0) {
+                close(fd);
+                return Tools::Format("Failed to read {0}", path);
+            }
+            auto p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (p == MAP_FAILED)
+                return Tools::Format("Failed to map {0}", path);
+            madvise(p, st.st_size, MADV_SEQUENTIAL);
+            this->data = p;
+            this->size = st.st_size;
+            return std::string();
+        }
+
+        ~MappedFile()
+        {
+            if (this->data != nullptr)
+                munmap(this->data, this->size);
+            return;
+        }
+    };
+
+    class ModelRegistry : public IModelRegistry {
+    private:
+        std::shared_ptr<Environment>          env;
+        std::map<std::string, IRatiocinate *> models;
+        std::set<std::string>                 loading;   // 加载中的模型名称
+        std::mutex                            mutex;
+        int                                   load_threads;
+
+        /**
+         * @brief    并行创建推理接口
+         * @param    models         模型列表
+         * @param    infers         推理接口(失败时全部释放)
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string Create(const std::vector<Model> &models, std::vector<Ratiocinate *> &infers)
+        {
+            // 同一文件只映射一次，会话创建完成后解除映射
+            std::map<std::string, std::shared_ptr<MappedFile>> files;
+            std::vector<IRatiocinate::Parameters>               params;
+            for (auto &m : models) {
+                auto p = m.params;
+                // 线程相关参数由全局线程池决定
+                p.threads = 0;
+                p.tuning.affinity.clear();
+                if (p.model_data == nullptr) {
+                    if (p.model == nullptr)
+                        return Tools::Format("{0}: The model cannot be empty", m.name);
+                    auto &file = files[p.model];
+                    if (file == nullptr) {
+                        file     = std::make_shared<MappedFile>();
+                        auto err = file->Open(p.model);
+                        if (!err.empty())
+                            return m.name + ": " + err;
+                    }
+                    p.model_data = file->data;
+                    p.model_size = file->size;
+                }
+                params.push_back($(p));
+            }
+            // 并行加载
+            std::vector<std::string> errs(models.size());
+            infers.assign(models.size(), nullptr);
+            {
+                Tools::ThreadPool pool(this->load_threads > 0 ? this->load_threads : (int)models.size());
+                for (size_t i = 0; i < models.size(); i++) {
+                    pool.Post([this, i, &infers, &errs, &params] {
+                        infers[i] = new Ratiocinate(this->env);
+                        errs[i]   = infers[i]->LoadModel(params[i]);
+                    });
+                }
+            }   // 等待全部完成
+            std::string err;
+            for (size_t i = 0; i < models.size(); i++) {
+                if (!errs[i].empty())
+                    err += (err.empty() ? "" : "; ") + models[i].name + ": " + errs[i];
+            }
+            if (!err.empty()) {
+                for (auto infer : infers)
+                    delete infer;
+                infers.clear();
+            }
+            return err;
+        }
+
+    public:
+        ModelRegistry(const std::shared_ptr<Environment> &env, int load_threads) :
+            env(env), load_threads(load_threads) {}
+
+        virtual ~ModelRegistry()
+        {
+            for (auto &it : this->models)
+                delete it.second;
+            return;
+        }
+
+        virtual std::string Load(const std::vector<Model> &models) override
+        {
+            if (models.size() == 0)
+                return std::string();
+            {
+                // 加载期间预留名称，并发加载同名模型时后来者失败
+                std::lock_guard<std::mutex> lock(this->mutex);
+                std::set<std::string>       names;
+                for (auto &m : models) {
+                    if (m.name.empty() || this->models.count(m.name) || this->loading.count(m.name) || !names.insert(m.name).second)
+                        return Tools::Format("Duplicate or empty model name: {0}", m.name);
+                }
+                this->loading.insert(names.begin(), names.end());
+            }
+            std::vector<Ratiocinate *>  infers;
+            auto                        err = this->Create(models, infers);
+            std::lock_guard<std::mutex> lock(this->mutex);
+            for (size_t i = 0; i < models.size(); i++) {
+                this->loading.erase(models[i].name);
+                if (err.empty())
+                    this->models[models[i].name] = infers[i];
+            }
+            return err;
+        }
+
+        virtual IRatiocinate *Get(const std::string &name) override
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            auto                        it = this->models.find(name);
+            return it == this->models.end() ? nullptr : it->second;
+        }
+
+        virtual strings Names() override
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            strings                     names;
+            for (auto &it : this->models)
+                names.push_back(it.first);
+            return names;
+        }
+    };
+
+    IModelRegistry *ModelRegistry_Create(const IModelRegistry::Parameters &params, std::string &err)
+    {
+        if (params.intra_op_threads < 0 || params.inter_op_threads < 0 || params.load_threads < 0) {
+            err = "The number of threads cannot be negative";
+            return nullptr;
+        }
+        try {
+            Ort::ThreadingOptions threading;
+            threading.SetGlobalIntraOpNumThreads(params.intra_op_threads);
+            threading.SetGlobalInterOpNumThreads(params.inter_op_threads);
+            threading.SetGlobalSpinControl(params.allow_spinning ? 1 : 0);
+            if (params.denormal_as_zero)
+                threading.SetGlobalDenormalAsZero();
+            auto env = std::make_shared<Environment>(static_cast<const OrtThreadingOptions *>(threading));
+            return new ModelRegistry(env, params.load_threads);
+        }
+        catch (std::exception &e) {
+            err = e.what();
+        }
+        return nullptr;
+    }
+
+    std::string Ratiocinate_CheckTuning(const IRatiocinate::Parameters &params)
+    {
+        auto &tuning = params.tuning;
+        if (params.threads < 0 || tuning.inter_op_threads < 0)
+            return "The number of threads cannot be negative";
+        if (tuning.execution != IRatiocinate::EXEC_SEQUENTIAL && tuning.execution != IRatiocinate::EXEC_PARALLEL)
+            return "Invalid execution mode";
+        if (tuning.inter_op_threads > 0 && tuning.execution != IRatiocinate::EXEC_PARALLEL)
+            return "inter_op_threads requires EXEC_PARALLEL";
+        if (tuning.arena_extend != IRatiocinate::ARENA_NEXT_POWER_OF_TWO && tuning.arena_extend != IRatiocinate::ARENA_SAME_AS_REQUESTED)
+            return "Invalid arena extend strategy";
+        if (tuning.affinity.empty())
+            return std::string();
+        // 亲和性: 每组以';'分隔，对应除主线程外的每个算子内线程，组内为逻辑处理器编号(从1开始)或范围"a-b"
+        auto groups = Tools::SplitString(tuning.affinity, ";");
+        if (params.threads <= 1 || (int)groups.size() != params.threads - 1)
+            return "The number of affinity groups must be threads - 1";
+        for (auto &group : groups) {
+            auto items = Tools::SplitString(group, ",");
+            if (items.size() == 0)
+                return "Empty affinity group";
+            for (auto &item : items) {
+                char *end = nullptr;
+                long  a   = strtol(item.c_str(), &end, 10);
+                long  b   = a;
+                if (end == item.c_str())
+                    return "Invalid affinity: " + item;
+                if (*end == '-') {
+                    const char *p = end + 1;
+                    b             = strtol(p, &end, 10);
+                    if (end == p)
+                        return "Invalid affinity: " + item;
+                }
+                if (*end != '\0' || a < 1 || b < a)
+                    return "Invalid affinity: " + item;
+            }
+        }
+        return std::string();
+    }
+
+    class BenchmarkWait {
+    public:
+        std::mutex              mutex;
+        std::condition_variable cond;
+        bool                    done = false;
+        std::string             err;
+
+        static void Callback(IRatiocinate                            *infer,
+                             const std::vector<std::string>          &input_names,
+                             const std::vector<Tensor<float>>        &input_datas,
+                             const std::vector<std::string>          &output_names,
+                             const std::vector<IRatiocinate::Result> &output_datas,
+                             void                                    *context,
+                             const std::string                       &err)
+        {
+            auto wait = static_cast<BenchmarkWait *>(context);
+            {
+                std::lock_guard<std::mutex> lock(wait->mutex);
+                wait->err  = err;
+                wait->done = true;
+            }
+            wait->cond.notify_one();
+            return;
+        }
+    };
+
+    static double CpuMillisecond()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+    }
+
+    static std::string BenchmarkRun(const IRatiocinate::Parameters         &params,
+                                    const std::vector<std::string>         &input_names,
+                                    const std::vector<std::string>         &output_names,
+                                    const std::vector<IRatiocinate::Input> &input_datas,
+                                    int                                     iterations,
+                                    BenchmarkResult                        &rs)
+    {
+        std::unique_ptr<IRatiocinate> infer(Ratiocinate_Create());
+        auto                          err = infer->LoadModel(params);
+        if (!err.empty())
+            return err;
+        IRatiocinate::Binding binding;
+        err = infer->Prepare(input_names, output_names, {}, binding);
+        if (!err.empty())
+            return err;
+        BenchmarkWait wait;
+        infer->callback         = BenchmarkWait::Callback;
+        infer->callback_context = &wait;
+
+        std::vector<double> latency;
+        double              cpu_start  = 0;
+        auto                wall_start = std::chrono::steady_clock::now();
+        // 第一次不计入统计
+        for (int i = -1; i < iterations; i++) {
+            if (i == 0) {
+                cpu_start  = CpuMillisecond();
+                wall_start = std::chrono::steady_clock::now();
+            }
+            auto start = std::chrono::steady_clock::now();
+            wait.done  = false;
+            err        = infer->ExecAsync(binding, input_datas);
+            if (!err.empty())
+                return err;
+            {
+                std::unique_lock<std::mutex> lock(wait.mutex);
+                wait.cond.wait(lock, [&wait] { return wait.done; });
+            }
+            if (!wait.err.empty())
+                return wait.err;
+            if (i >= 0)
+                latency.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+        double cpu  = CpuMillisecond() - cpu_start;
+        std::sort(latency.begin(), latency.end());
+        double sum = 0;
+        for (auto v : latency) sum += v;
+        rs.tuning    = params.tuning;
+        rs.avg_ms    = sum / latency.size();
+        rs.p50_ms    = latency[latency.size() / 2];
+        rs.p99_ms    = latency[std::min(latency.size() - 1, latency.size() * 99 / 100)];
+        rs.max_ms    = latency.back();
+        rs.cpu_ms    = cpu / latency.size();
+        rs.cpu_usage = wall > 0 ? cpu / wall : 0;
+        return std::string();
+    }
+
+    std::string Ratiocinate_Benchmark(const IRatiocinate::Parameters         &params,
+                                      const std::vector<std::string>         &input_names,
+                                      const std::vector<std::string>         &output_names,
+                                      const std::vector<IRatiocinate::Input> &input_datas,
+                                      int                                     iterations,
+                                      std::vector<BenchmarkResult>           &results)
+    {
+        if (iterations <= 0)
+            return "The number of iterations must be greater than 0";
+        auto err = Ratiocinate_CheckTuning(params);
+        if (!err.empty())
+            return err;
+        // 每个配置只改变一个参数，便于比较单个参数的影响
+        std::vector<std::pair<std::string, IRatiocinate::Parameters>> variants;
+        auto                                                          base = params;
+        variants.push_back({"base", base});
+        auto tmp = base;
+        if (base.tuning.execution == IRatiocinate::EXEC_SEQUENTIAL) {
+            tmp.tuning.execution        = IRatiocinate::EXEC_PARALLEL;
+            tmp.tuning.inter_op_threads = 2;
+            variants.push_back({"execution=parallel,inter_op_threads=2", tmp});
+        } else {
+            tmp.tuning.execution        = IRatiocinate::EXEC_SEQUENTIAL;
+            tmp.tuning.inter_op_threads = 0;
+            variants.push_back({"execution=sequential", tmp});
+        }
+        tmp                       = base;
+        tmp.tuning.allow_spinning = !base.tuning.allow_spinning;
+        variants.push_back({Tools::Format("allow_spinning={0}", (int)tmp.tuning.allow_spinning), tmp});
+        tmp                  = base;
+        tmp.tuning.cpu_arena = !base.tuning.cpu_arena;
+        variants.push_back({Tools::Format("cpu_arena={0}", (int)tmp.tuning.cpu_arena), tmp});
+        if (base.tuning.cpu_arena) {
+            tmp                     = base;
+            tmp.tuning.arena_extend = base.tuning.arena_extend == IRatiocinate::ARENA_NEXT_POWER_OF_TWO
+                                          ? IRatiocinate::ARENA_SAME_AS_REQUESTED
+                                          : IRatiocinate::ARENA_NEXT_POWER_OF_TWO;
+            variants.push_back({tmp.tuning.arena_extend == IRatiocinate::ARENA_SAME_AS_REQUESTED
+                                    ? "arena_extend=same_as_requested"
+                                    : "arena_extend=next_power_of_two",
+                                tmp});
+        }
+        tmp                         = base;
+        tmp.tuning.denormal_as_zero = !base.tuning.denormal_as_zero;
+        variants.push_back({Tools::Format("denormal_as_zero={0}", (int)tmp.tuning.denormal_as_zero), tmp});
+
+        results.clear();
+        for (auto &v : variants) {
+            BenchmarkResult rs;
+            rs.name = v.first;
+            err     = BenchmarkRun(v.second, input_names, output_names, input_datas, iterations, rs);
+            if (!err.empty())
+                return v.first + ": " + err;
+            results.push_back($(rs));
+        }
+        return std::string();
+    }
+
+    std::string Ratiocinate_BenchmarkReport(const std::vector<BenchmarkResult> &results)
+    {
+        std::string str;
+        char        line[256];
+        snprintf(line, sizeof(line), "%-40s %9s %9s %9s %9s %9s %7s\n", "config", "avg(ms)", "p50(ms)", "p99(ms)", "max(ms)", "cpu(ms)", "cpu(%)");
+        str += line;
+        for (auto &rs : results) {
+            snprintf(line,
+                     sizeof(line),
+                     "%-40s %9.2f %9.2f %9.2f %9.2f %9.2f %7.1f\n",
+                     rs.name.c_str(),
+                     rs.avg_ms,
+                     rs.p50_ms,
+                     rs.p99_ms,
+                     rs.max_ms,
+                     rs.cpu_ms,
+                     rs.cpu_usage * 100);
+            str += line;
+        }
+        return str;
+    }
+#endif
 }   // namespace AIMethod
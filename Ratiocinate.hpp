@@ -16,7 +16,10 @@
 #if !defined(__Ratiocinate_HPP__)
 #define __Ratiocinate_HPP__
 #include "Tools.CV.hpp"
+#include "Tools.Thread.hpp"
 #include "Tensor.hpp"
+#include <future>
+#include <map>
 
 // 设置推理引擎
 
@@ -32,6 +35,11 @@
 #define EN_GPU 0
 #endif
 
+// 取消/超时/过载丢弃的错误信息(回调err)
+#define ERR_RATIOCINATE_CANCELED "Canceled"
+#define ERR_RATIOCINATE_DEADLINE "Deadline exceeded"
+#define ERR_RATIOCINATE_DROPPED  "Dropped"
+
 namespace AIMethod {
 
     /**
@@ -40,50 +48,237 @@ namespace AIMethod {
      * @date     2024-01-10
      */
     class IRatiocinate {
-    protected:
-        std::atomic<int> is_runing;   // 正在运行
+    public:
+        /**
+         * @brief    取消句柄(可复制，副本共享状态)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        class CancelHandle {
+        public:
+            class State {
+            private:
+                std::mutex            mutex;
+                const char           *reason = nullptr;   // 取消原因(nullptr:未取消)
+                std::function<void()> terminate;          // 终止正在执行的任务
+
+            public:
+                /**
+                 * @brief    取消(仅第一次有效)
+                 * @param    why            原因
+                 * @author   CXS (chenxiangshu@outlook.com)
+                 * @date     2026-10-18
+                 */
+                void Cancel(const char *why)
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    if (this->reason != nullptr)
+                        return;
+                    this->reason = why;
+                    if (this->terminate)
+                        this->terminate();
+                    return;
+                }
+
+                /**
+                 * @brief    设置终止函数(在执行期间设置，完成后清空，已取消时立即调用)
+                 * @param    fn             终止函数
+                 * @author   CXS (chenxiangshu@outlook.com)
+                 * @date     2026-10-18
+                 */
+                void Attach(std::function<void()> fn)
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->terminate = $(fn);
+                    if (this->reason != nullptr && this->terminate)
+                        this->terminate();
+                    return;
+                }
+
+                const char *Reason()
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    return this->reason;
+                }
+            };
+
+        private:
+            std::shared_ptr<State> state;
 
-        class IStatus {
         public:
-            IRatiocinate              *infer;
-            std::vector<std::string>   input_names;
-            std::vector<std::string>   output_names;
-            std::vector<Tensor<float>> input_datas;
-        };
+            /**
+             * @brief    创建句柄(默认构造的句柄为空)
+             * @return   CancelHandle
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            static CancelHandle Create()
+            {
+                CancelHandle h;
+                h.state = std::make_shared<State>();
+                return h;
+            }
 
-    public:
-        IRatiocinate() :
-            is_runing(0)
-        {
-        }
+            /**
+             * @brief    取消任务(未开始的任务直接丢弃，执行中的任务尽快终止)
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            void Cancel()
+            {
+                if (this->state) this->state->Cancel(ERR_RATIOCINATE_CANCELED);
+            }
 
-        virtual ~IRatiocinate() = default;
+            bool IsCanceled() const
+            {
+                return this->state && this->state->Reason() != nullptr;
+            }
+
+            inline bool Empty() const { return this->state == nullptr; }
+
+            inline const std::shared_ptr<State> &GetState() const { return this->state; }
+        };
 
         /**
-         * @brief    正在运行
-         * @return   true
-         * @return   false
+         * @brief    推理结果(持有输出数据，可传递到其他线程使用，最后一个引用释放时归还推理引擎)
          * @author   CXS (chenxiangshu@outlook.com)
          * @date     2024-01-12
          */
-        virtual bool IsRun() = 0;
+        typedef Tensor<float> Result;
 
         /**
-         * @brief    推理结果
+         * @brief    推理输入(可由各类型张量隐式构造，元素类型需与模型输入一致)
+         * @note     模型输入改为uint8后(见prologue.py)，图像数据可直接作为输入，归一化在模型中完成
          * @author   CXS (chenxiangshu@outlook.com)
-         * @date     2024-01-12
+         * @date     2026-10-18
          */
-        typedef struct
-        {
-            std::vector<int> shape;
-            const float     *data;   // 仅在ExecCallback_t有效
-        } Result;
+        class Input {
+        public:
+            typedef enum
+            {
+                TYPE_FLOAT   = 0,   // float32
+                TYPE_UINT8   = 1,   // uint8
+                TYPE_INT64   = 2,   // int64
+                TYPE_FLOAT16 = 3,   // float16
+            } Type;
+
+        private:
+            Type            type = TYPE_FLOAT;
+            Tensor<float>   f32;
+            Tensor<uint8_t> u8;
+            Tensor<int64_t> i64;
+            Tensor<Float16> f16;
+
+        public:
+            Input() {}
+            Input(const Tensor<float> &t) :
+                type(TYPE_FLOAT), f32(t) {}
+            Input(const Tensor<uint8_t> &t) :
+                type(TYPE_UINT8), u8(t) {}
+            Input(const Tensor<int64_t> &t) :
+                type(TYPE_INT64), i64(t) {}
+            Input(const Tensor<Float16> &t) :
+                type(TYPE_FLOAT16), f16(t) {}
+
+            inline Type GetType() const
+            {
+                return this->type;
+            }
+
+            const std::vector<int> &GetShape() const
+            {
+                switch (this->type) {
+                    case TYPE_UINT8: return this->u8.GetShape();
+                    case TYPE_INT64: return this->i64.GetShape();
+                    case TYPE_FLOAT16: return this->f16.GetShape();
+                    default: return this->f32.GetShape();
+                }
+            }
+
+            /**
+             * @brief    元素数量
+             * @return   size_t
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            size_t Size() const
+            {
+                switch (this->type) {
+                    case TYPE_UINT8: return this->u8.Size();
+                    case TYPE_INT64: return this->i64.Size();
+                    case TYPE_FLOAT16: return this->f16.Size();
+                    default: return this->f32.Size();
+                }
+            }
+
+            /**
+             * @brief    数据长度(字节)
+             * @return   size_t
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            size_t Bytes() const
+            {
+                switch (this->type) {
+                    case TYPE_UINT8: return this->u8.Size();
+                    case TYPE_INT64: return this->i64.Size() * sizeof(int64_t);
+                    case TYPE_FLOAT16: return this->f16.Size() * sizeof(Float16);
+                    default: return this->f32.Size() * sizeof(float);
+                }
+            }
+
+            const void *Data() const
+            {
+                switch (this->type) {
+                    case TYPE_UINT8: return this->u8.Value();
+                    case TYPE_INT64: return this->i64.Value();
+                    case TYPE_FLOAT16: return this->f16.Value();
+                    default: return this->f32.Value();
+                }
+            }
+
+            /**
+             * @brief    float输入(其他类型为空张量)
+             * @return   const Tensor<float>&
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            inline const Tensor<float> &Float() const
+            {
+                return this->f32;
+            }
+
+            /**
+             * @brief    转换为float输入列表(推理回调使用，其他类型为空张量)
+             * @param    inputs         输入
+             * @return   std::vector<Tensor<float>>
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            static std::vector<Tensor<float>> Floats(const std::vector<Input> &inputs)
+            {
+                std::vector<Tensor<float>> rs;
+                rs.reserve(inputs.size());
+                for (auto &input : inputs)
+                    rs.push_back(input.f32);
+                return rs;
+            }
+        };
+
+        /**
+         * @brief    任务完成回调(每个任务独立)
+         * @param    outputs        推理输出
+         * @param    err            错误信息
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef std::function<void(const std::vector<Result> &outputs, const std::string &err)> Completion_t;
 
         /**
          * @brief    执行回调
-         * @param    infer         推理接口
+         * @param    infer         推理接口(在执行器中回调时推理接口可能已销毁，此时不可访问)
          * @param    input_names   输入名称
-         * @param    input_datas   输入数据
+         * @param    input_datas   输入数据(非float输入为空张量)
          * @param    output_names  输出名称
          * @param    output_names  输出名称
          * @param    output_datas  输出数据
@@ -100,6 +295,614 @@ namespace AIMethod {
                                        void                                    *context,
                                        const std::string                       &err);
 
+        /**
+         * @brief    优先级(按权重公平调度，同优先级先进先出)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef enum
+        {
+            PRIORITY_REALTIME    = 0,   // 实时(如实时视频流)
+            PRIORITY_INTERACTIVE = 1,   // 交互(默认)
+            PRIORITY_BATCH       = 2,   // 批处理(如历史录像回补，利用空闲算力)
+            PRIORITY_COUNT,
+        } Priority;
+
+        /**
+         * @brief    执行选项
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            uint64_t          deadline_ns = 0;                      // 截止时间(Tools::GetNanosecond时钟，0:不限制，排队中到期时立即回调)
+            CancelHandle      cancel;                               // 取消句柄(可为空)
+            Priority          priority    = PRIORITY_INTERACTIVE;   // 优先级
+            Completion_t      done;                                 // 任务完成回调(不为空时替代推理回调，提交失败也会调用，仅调用一次)
+            Tools::IExecutor *executor    = nullptr;                // 执行任务完成回调的执行器(为空时使用Parameters.executor)
+        } ExecOptions;
+
+        /**
+         * @brief    任务结果
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            std::vector<Result> outputs;   // 推理输出
+            std::string         err;       // 错误信息
+        } Reply;
+
+        /**
+         * @brief    执行绑定(由Prepare创建并校验，可在多次执行中复用)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        class IBinding {
+        public:
+            std::vector<std::string>      input_names;    // 输入名称
+            std::vector<std::string>      output_names;   // 输出名称
+            std::vector<std::vector<int>> shapes;         // 输入形状(为空时不限制，-1为动态维度)
+            std::vector<size_t>           sizes;          // 输入元素数量(0:含动态维度，不检查)
+
+            virtual ~IBinding() = default;
+        };
+        typedef std::shared_ptr<const IBinding> Binding;
+
+        /**
+         * @brief    输入缓冲环(预分配、按页对齐并锁定在内存中的输入缓冲区)
+         * @note     Acquire取得空闲槽位，预处理直接写入后作为输入提交，推理直接使用槽位内存(不拷贝)；
+         *           推理完成且所有引用释放后槽位自动归还，全部占用时Acquire等待；
+         *           两个槽位即双缓冲: 推理读取A时预处理写入B
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        class InputRing {
+        private:
+            class State {
+            public:
+                std::mutex              mutex;
+                std::condition_variable cond;
+                std::vector<void *>     slots;       // 全部槽位
+                std::vector<void *>     idle;        // 空闲槽位
+                size_t                  bytes = 0;   // 槽位大小
+
+                ~State();
+                void Release(void *slot);
+            };
+
+            std::shared_ptr<State> state;
+            std::vector<int>       shape;
+            size_t                 size  = 0;   // 元素数量
+            size_t                 bytes = 0;   // 输入大小(字节，不含页对齐填充)
+
+            void *Pop(bool wait);
+
+            template<typename T>
+            Tensor<T> Make(void *slot)
+            {
+                auto state = this->state;
+                return Tensor<T>::MakeExternal(this->shape, (T *)slot, [state, slot] { state->Release(slot); });
+            }
+
+        public:
+            /**
+             * @brief    创建缓冲环
+             * @param    shape          输入形状
+             * @param    bytes          槽位大小(字节)
+             * @param    count          槽位数量
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            InputRing(const std::vector<int> &shape, size_t bytes, int count);
+
+            InputRing(const InputRing &)            = delete;
+            InputRing &operator=(const InputRing &) = delete;
+
+            /**
+             * @brief    取得空闲槽位(全部占用时等待)
+             * @tparam   T              元素类型
+             * @return   Tensor<T>      槽位(内容为上次使用的数据)
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            template<typename T>
+            Tensor<T> Acquire()
+            {
+                if (this->size * sizeof(T) > this->bytes)
+                    RUN_ERR("The element type does not fit the input ring");
+                return this->Make<T>(this->Pop(true));
+            }
+
+            /**
+             * @brief    尝试取得空闲槽位(不等待)
+             * @param    tensor         [out]槽位
+             * @return   true           成功
+             * @return   false          全部占用
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            template<typename T>
+            bool TryAcquire(Tensor<T> &tensor)
+            {
+                if (this->size * sizeof(T) > this->bytes)
+                    RUN_ERR("The element type does not fit the input ring");
+                void *slot = this->Pop(false);
+                if (slot == nullptr)
+                    return false;
+                tensor = this->Make<T>(slot);
+                return true;
+            }
+
+            /**
+             * @brief    空闲槽位数量
+             * @return   size_t
+             * @author   CXS (chenxiangshu@outlook.com)
+             * @date     2026-10-18
+             */
+            size_t Idle() const;
+
+            inline const std::vector<int> &GetShape() const { return this->shape; }
+        };
+
+        /**
+         * @brief    是否因取消/超时失败
+         * @param    err            回调错误信息
+         * @return   true
+         * @return   false
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static bool IsCanceled(const std::string &err)
+        {
+            return err == ERR_RATIOCINATE_CANCELED || err == ERR_RATIOCINATE_DEADLINE;
+        }
+
+        /**
+         * @brief    是否因过载被丢弃
+         * @param    err            回调错误信息
+         * @return   true
+         * @return   false
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static bool IsDropped(const std::string &err)
+        {
+            return err == ERR_RATIOCINATE_DROPPED;
+        }
+
+        /**
+         * @brief    过载策略(排队已满或积压时的处理)
+         * @note     实时视频流处理最新帧比处理每一帧更重要，应使用 OVERLOAD_KEEP_LATEST 或 OVERLOAD_ADAPTIVE
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef enum
+        {
+            OVERLOAD_DROP_NEWEST = 0,   // 队列满时丢弃新任务(提交失败，默认)
+            OVERLOAD_DROP_OLDEST = 1,   // 队列满时丢弃最早排队的任务
+            OVERLOAD_KEEP_LATEST = 2,   // 只保留最新的任务(新任务替换所有排队中的任务)
+            OVERLOAD_ADAPTIVE    = 3,   // 自适应跳帧: 有积压时按间隔跳过新任务，间隔随积压加倍、空闲时减半
+        } Overload;
+
+        /**
+         * @brief    调度参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            int      max_inflight            = 0;                      // 最大同时执行任务数(0:ONNXRuntime为1，OpenCV为workers)
+            size_t   max_queue               = 16;                     // 每个优先级的最大排队数(超出时按过载策略处理，0:不限制)
+            int      weights[PRIORITY_COUNT] = {16, 4, 1};             // 各优先级权重，争用时按权重比例分配执行次数
+            uint64_t starvation_ns           = 500000000ULL;           // 防饥饿周期: 队首等待超过该时间时提前调度一次(0:不启用)
+            Overload overload                = OVERLOAD_DROP_NEWEST;   // 过载策略(各优先级独立处理)
+            int      max_skip                = 8;                      // 自适应跳帧的最大间隔(每处理1帧最多跳过的帧数)
+        } Scheduling;
+
+    protected:
+        std::atomic<int> is_runing;   // 排队和执行中的任务数(任务结束时最后减少，之后不再访问推理接口)
+
+        Tools::Histogram stat_queue;                           // 提交->开始执行(纳秒)
+        Tools::Histogram stat_queue_priority[PRIORITY_COUNT];   // 各优先级排队(纳秒)
+        Tools::Histogram stat_run;                             // 执行(纳秒)
+
+        std::shared_ptr<Tools::Histogram> stat_callback;   // 回调(纳秒，执行器中排队的回调可能晚于推理接口销毁，共享持有)
+
+        Tools::IExecutor *completion_executor = nullptr;   // 完成回调执行器(Parameters.executor)
+
+        std::atomic<uint64_t> stat_dropped[PRIORITY_COUNT];   // 各优先级过载丢弃数
+
+        class IStatus {
+        public:
+            IRatiocinate              *infer;
+            Binding                    binding;
+            std::vector<Input>         input_datas;
+            Priority                   priority  = PRIORITY_INTERACTIVE;
+            uint64_t                   submit_ns = 0;   // 提交时间
+            uint64_t                   start_ns  = 0;   // 开始执行时间
+
+            virtual ~IStatus() = default;
+
+            std::shared_ptr<CancelHandle::State> cancel;      // 取消状态(无截止时间且无取消句柄时为空)
+            uint64_t                             timer = 0;   // 截止时间定时器
+
+            Completion_t      done;                 // 任务完成回调
+            Tools::IExecutor *executor = nullptr;   // 任务完成回调的执行器
+        };
+
+        /**
+         * @brief    是否需要通知(没有回调时不必整理输出)
+         * @param    status         任务
+         * @return   true
+         * @return   false
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool NeedNotify(const IStatus *status) const
+        {
+            return status->done || this->callback != nullptr;
+        }
+
+        /**
+         * @brief    完成通知(有任务完成回调时调用任务完成回调，否则调用推理回调)
+         * @param    binding        执行绑定(可为空)
+         * @param    input_datas    输入数据
+         * @param    outputs        推理输出
+         * @param    err            错误信息
+         * @param    done           任务完成回调
+         * @param    executor       回调执行器(为空时使用完成回调执行器，都为空时在当前线程执行)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Notify(const Binding                    &binding,
+                    const std::vector<Input>         &input_datas,
+                    std::vector<Result>             &&outputs,
+                    const std::string                &err,
+                    const Completion_t               &done,
+                    Tools::IExecutor                 *executor)
+        {
+            if (!done && this->callback == nullptr)
+                return;
+            if (executor == nullptr)
+                executor = this->completion_executor;
+            if (executor == nullptr) {
+                Callback(this, *this->stat_callback, binding, input_datas, outputs, err, done, this->callback, this->callback_context);
+                return;
+            }
+            // 投递的回调不访问推理接口(推理接口可能先于回调销毁)，只捕获需要的值
+            // 执行器已停止或队列已满时在当前线程执行，保证只调用一次
+            auto outs  = std::make_shared<std::vector<Result>>($(outputs));
+            auto stat  = this->stat_callback;
+            auto cb    = this->callback;
+            auto ctx   = this->callback_context;
+            auto infer = this;   // 仅作为推理回调的参数
+            if (!executor->Post([infer, stat, binding, input_datas, outs, err, done, cb, ctx] {
+                    Callback(infer, *stat, binding, input_datas, *outs, err, done, cb, ctx);
+                }))
+                Callback(this, *stat, binding, input_datas, *outs, err, done, cb, ctx);
+            return;
+        }
+
+        /**
+         * @brief    调用回调并记录耗时
+         * @note     推理回调和上下文在提交回调时确定，避免回调执行前被修改；
+         *           在执行器中调用时推理接口可能已销毁，只使用传入的值
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static void Callback(IRatiocinate                     *infer,
+                             Tools::Histogram                 &stat,
+                             const Binding                    &binding,
+                             const std::vector<Input>         &input_datas,
+                             const std::vector<Result>        &outputs,
+                             const std::string                &err,
+                             const Completion_t               &done,
+                             ExecCallback_t                    callback,
+                             void                             *context)
+        {
+            static const std::vector<std::string> empty;
+            auto                                  callback_ns = Tools::GetNanosecond();
+            if (done)
+                done(outputs, err);
+            else if (callback != nullptr)
+                callback(infer,
+                         binding != nullptr ? binding->input_names : empty,
+                         Input::Floats(input_datas),
+                         binding != nullptr ? binding->output_names : empty,
+                         outputs,
+                         context,
+                         err);
+            stat.Record(Tools::GetNanosecond() - callback_ns);
+            return;
+        }
+
+        void Notify(const IStatus *status, std::vector<Result> &&outputs, const std::string &err)
+        {
+            this->Notify(status->binding, status->input_datas, $(outputs), err, status->done, status->executor);
+            return;
+        }
+
+        /**
+         * @brief    准备取消(提交时调用，设置截止时间定时器)
+         * @param    status         任务
+         * @param    options        执行选项
+         * @return   std::string    已取消或已超时返回对应错误(此时未设置定时器)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string ArmCancel(IStatus *status, const ExecOptions &options)
+        {
+            status->cancel = options.cancel.GetState();
+            if (status->cancel != nullptr && status->cancel->Reason() != nullptr)
+                return status->cancel->Reason();
+            if (options.deadline_ns == 0)
+                return std::string();
+            if (Tools::GetNanosecond() >= options.deadline_ns)
+                return ERR_RATIOCINATE_DEADLINE;
+            if (status->cancel == nullptr)
+                status->cancel = std::make_shared<CancelHandle::State>();
+            // 到期时终止执行中的任务，排队中的任务不等下一次调度直接丢弃(DisarmCancel等待本任务结束)
+            auto state    = status->cancel;
+            status->timer = Tools::Timer::Default().Add(options.deadline_ns, [this, state] {
+                state->Cancel(ERR_RATIOCINATE_DEADLINE);
+                this->DropExpired();
+            });
+            return std::string();
+        }
+
+        /**
+         * @brief    解除取消(执行完成时调用，在释放终止函数引用的对象之前)
+         * @param    status         任务
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void DisarmCancel(IStatus *status)
+        {
+            if (status->timer != 0)
+                Tools::Timer::Default().Remove(status->timer);
+            status->timer = 0;
+            if (status->cancel != nullptr)
+                status->cancel->Attach(nullptr);
+            return;
+        }
+
+        /**
+         * @brief    初始化绑定(填写名称和形状，计算固定形状的元素数量)
+         * @param    binding        绑定
+         * @param    input_names    输入名称
+         * @param    output_names   输出名称
+         * @param    shapes         输入形状(可为空)
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static std::string InitBinding(IBinding                            &binding,
+                                       const std::vector<std::string>      &input_names,
+                                       const std::vector<std::string>      &output_names,
+                                       const std::vector<std::vector<int>> &shapes)
+        {
+            if (input_names.size() == 0 || output_names.size() == 0)
+                return "The input parameter cannot be empty";
+            if (shapes.size() != 0 && shapes.size() != input_names.size())
+                return "The number of shapes does not match the inputs";
+            binding.input_names  = input_names;
+            binding.output_names = output_names;
+            binding.shapes       = shapes;
+            binding.sizes.assign(input_names.size(), 0);
+            for (size_t i = 0; i < shapes.size(); i++) {
+                size_t size = 1;
+                for (auto v : shapes[i]) {
+                    if (v == 0 || v < -1)
+                        return Tools::Format("Invalid input shape: {0}", input_names[i]);
+                    size = v < 0 ? 0 : size * v;
+                }
+                binding.sizes[i] = size;
+            }
+            return std::string();
+        }
+
+        /**
+         * @brief    记录执行耗时(执行完成时调用)
+         * @param    status         任务
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void RecordRun(const IStatus *status)
+        {
+            auto end_ns = Tools::GetNanosecond();
+            this->stat_queue.Record(status->start_ns - status->submit_ns);
+            this->stat_queue_priority[status->priority].Record(status->start_ns - status->submit_ns);
+            this->stat_run.Record(end_ns - status->start_ns);
+            return;
+        }
+
+        // --------------------------------------------------------------------------------
+        //                                调度
+        // --------------------------------------------------------------------------------
+
+        Scheduling            scheduling;
+        int                   sched_inflight = 1;   // 最大同时执行任务数
+        int                   sched_running  = 0;   // 执行中的任务数
+        std::mutex            sched_mutex;
+        std::deque<IStatus *> sched_queues[PRIORITY_COUNT];
+        double                sched_vtime[PRIORITY_COUNT]     = {0};   // 各优先级虚拟时间
+        double                sched_clock                     = 0;     // 最后调度的虚拟时间
+        uint64_t              sched_boost_ns[PRIORITY_COUNT]  = {0};   // 各优先级最后一次防饥饿调度时间
+        int                   sched_skip[PRIORITY_COUNT]      = {0};   // 各优先级自适应跳帧间隔
+        int                   sched_skip_left[PRIORITY_COUNT] = {0};   // 各优先级剩余跳过帧数
+
+        /**
+         * @brief    设置调度参数(加载模型时调用)
+         * @param    scheduling     调度参数
+         * @param    def_inflight   默认最大同时执行任务数
+         * @param    max_inflight   引擎允许的最大同时执行任务数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void SetScheduling(const Scheduling &scheduling, int def_inflight, int max_inflight);
+
+        /**
+         * @brief    任务入队并尝试调度(is_runing已计入该任务)
+         * @note     按过载策略丢弃的排队任务以ERR_RATIOCINATE_DROPPED回调
+         * @param    status         任务
+         * @return   std::string    新任务被丢弃时返回ERR_RATIOCINATE_DROPPED(任务未入队)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string Enqueue(IStatus *status);
+
+        /**
+         * @brief    任务执行完成(释放执行名额并调度下一个任务)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Finish();
+
+        /**
+         * @brief    取消所有排队中的任务(销毁时调用)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void DropQueued();
+
+        /**
+         * @brief    丢弃排队中已取消或已超时的任务(截止时间到期时调用)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void DropExpired();
+
+        /**
+         * @brief    等待所有任务结束(销毁时在DropQueued之后、释放会话之前调用，不能在回调中销毁)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void WaitIdle();
+
+        /**
+         * @brief    开始执行任务(由调度调用，执行完成后需调用Finish)
+         * @param    status         任务
+         * @return   std::string    提交失败时返回错误(由调度回调并释放任务，引擎不再访问任务)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual std::string Dispatch(IStatus *status) = 0;
+
+    private:
+        IStatus *Pick(bool run, std::vector<IStatus *> &dropped);
+        void     Schedule();
+        void     Drop(IStatus *status, const std::string &reason);
+
+    public:
+        IRatiocinate() :
+            is_runing(0), stat_callback(std::make_shared<Tools::Histogram>())
+        {
+            for (auto &n : this->stat_dropped)
+                n.store(0);
+        }
+
+        virtual ~IRatiocinate() = default;
+
+        /**
+         * @brief    正在运行
+         * @return   true
+         * @return   false
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2024-01-12
+         */
+        virtual bool IsRun() = 0;
+
+        /**
+         * @brief    耗时统计(纳秒)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            Tools::Histogram::Summary queue;                           // 提交->开始执行(排队)
+            Tools::Histogram::Summary queue_priority[PRIORITY_COUNT];   // 各优先级排队
+            Tools::Histogram::Summary run;                             // 执行(throughput即推理吞吐量)
+            Tools::Histogram::Summary callback;                        // 回调
+            uint64_t                  dropped[PRIORITY_COUNT];         // 各优先级过载丢弃数
+        } Statistics;
+
+        /**
+         * @brief    获取耗时统计
+         * @return   Statistics
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        Statistics GetStatistics() const
+        {
+            Statistics rs;
+            rs.queue    = this->stat_queue.Snapshot();
+            for (int i = 0; i < PRIORITY_COUNT; i++)
+                rs.queue_priority[i] = this->stat_queue_priority[i].Snapshot();
+            rs.run      = this->stat_run.Snapshot();
+            rs.callback = this->stat_callback->Snapshot();
+            for (int i = 0; i < PRIORITY_COUNT; i++)
+                rs.dropped[i] = this->stat_dropped[i].load();
+            return rs;
+        }
+
+        /**
+         * @brief    清空耗时统计
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void ResetStatistics()
+        {
+            this->stat_queue.Reset();
+            for (auto &stat : this->stat_queue_priority)
+                stat.Reset();
+            this->stat_run.Reset();
+            this->stat_callback->Reset();
+            for (auto &n : this->stat_dropped)
+                n.store(0);
+            return;
+        }
+
+#if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
+        /**
+         * @brief    执行模式
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef enum
+        {
+            EXEC_SEQUENTIAL = 0,   // 顺序执行算子
+            EXEC_PARALLEL   = 1,   // 并行执行算子(使用算子间线程)
+        } ExecMode;
+
+        /**
+         * @brief    内存池扩展策略
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef enum
+        {
+            ARENA_NEXT_POWER_OF_TWO = 0,   // 按2的幂扩展(默认)
+            ARENA_SAME_AS_REQUESTED = 1,   // 按申请大小扩展(内存占用更小)
+        } ArenaExtend;
+
+        /**
+         * @brief    会话调优参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            int         inter_op_threads = 0;                         // 算子间线程数(0:默认，仅EXEC_PARALLEL有效)
+            ExecMode    execution        = EXEC_SEQUENTIAL;           // 执行模式
+            bool        allow_spinning   = true;                      // 线程空闲时自旋等待(降低延时，增加CPU占用)
+            bool        cpu_arena        = true;                      // 启用CPU内存池
+            ArenaExtend arena_extend     = ARENA_NEXT_POWER_OF_TWO;   // 内存池扩展策略
+            bool        denormal_as_zero = false;                     // 非规格化浮点数按0处理
+            std::string affinity;                                     // 算子内线程亲和性(为空不设置)，如"1,2;3-4"，组数为threads-1
+        } Tuning;
+#endif
+
         /**
          * @brief    参数
          * @author   CXS (chenxiangshu@outlook.com)
@@ -107,9 +910,26 @@ namespace AIMethod {
          */
         typedef struct
         {
-            const char *model;   // 模型文件
+            const char       *model      = nullptr;   // 模型文件
+            Scheduling        scheduling;             // 调度参数
+            Tools::IExecutor *executor   = nullptr;   // 完成回调执行器(为空时在推理线程执行回调)
 #if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
-            int threads;   // 线程数量
+            int    threads = 0;   // 线程数量(0:ONNXRuntime默认，使用全局线程池时无效)
+            Tuning tuning;        // 会话调优(使用全局线程池时线程相关参数无效)
+
+            const void *model_data = nullptr;   // 模型数据(不为空时从内存加载，model仅作为名称)
+            size_t      model_size = 0;         // 模型数据长度
+
+            const char                   *cache_dir = nullptr;   // 优化模型缓存目录(为空不缓存)
+            int                           warmup    = 0;         // 预热次数(0不预热)
+            std::vector<std::vector<int>> warmup_shapes;         // 预热输入形状(为空时使用模型形状，动态维度取1)
+
+            // 动态维度特化: 覆盖后的维度按常量优化(形状推导、常量折叠、内核选择)
+            std::map<std::string, int64_t> free_dims;              // 按维度名称覆盖，如{"batch", 1}
+            std::map<std::string, int64_t> free_dims_denotation;   // 按维度标注覆盖，如{"DATA_BATCH", 1}
+            int                            shape_sessions = 0;     // 按具体输入形状特化的会话缓存数量(0:不特化，每个会话占用一份模型内存)
+#elif CFG_INFER_ENGINE == INFER_ENGINE_OPENCV
+            int workers = 1;   // 工作线程数量(每个线程独立网络，即最大并行任务数)
 #endif
         } Parameters;
 
@@ -126,17 +946,142 @@ namespace AIMethod {
         virtual std::string LoadModel(const Parameters &params) = 0;
 
         /**
-         * @brief    异步执行
+         * @brief    准备执行绑定(加载模型后调用，按模型信息校验名称和形状)
+         * @param    input_names    输入名称
+         * @param    output_names   输出名称
+         * @param    shapes         输入形状(可为空，-1为动态维度)
+         * @param    binding        [out]执行绑定
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual std::string Prepare(const std::vector<std::string>      &input_names,
+                                    const std::vector<std::string>      &output_names,
+                                    const std::vector<std::vector<int>> &shapes,
+                                    Binding                             &binding) = 0;
+
+        /**
+         * @brief    创建绑定输入的缓冲环(输入形状需固定)
+         * @param    binding        执行绑定
+         * @param    index          输入序号
+         * @param    count          槽位数量(2:双缓冲)
+         * @param    ring           [out]缓冲环
+         * @param    type           元素类型
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string CreateInputRing(const Binding              &binding,
+                                    size_t                      index,
+                                    int                         count,
+                                    std::shared_ptr<InputRing> &ring,
+                                    Input::Type                 type = Input::TYPE_FLOAT);
+
+        /**
+         * @brief    异步执行(使用已准备的绑定，不再处理名称)
+         * @note     超时或取消的任务: 未开始则丢弃，执行中则终止(OpenCV无法终止执行中的任务)，
+         *           回调err为ERR_RATIOCINATE_DEADLINE/ERR_RATIOCINATE_CANCELED；
+         *           提交时已超时或已取消直接返回对应错误；
+         *           按过载策略丢弃的任务返回或回调ERR_RATIOCINATE_DROPPED
+         * @param    binding        执行绑定
+         * @param    input_datas    输入参数(与绑定的输入一一对应)
+         * @param    options        执行选项
+         * @return   std::string
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual std::string ExecAsync(const Binding                    &binding,
+                                      const std::vector<Input>         &input_datas,
+                                      const ExecOptions                &options) = 0;
+
+        std::string ExecAsync(const Binding &binding, const std::vector<Input> &input_datas)
+        {
+            return this->ExecAsync(binding, input_datas, ExecOptions());
+        }
+
+        /**
+         * @brief    异步执行(同类型张量列表)
+         * @tparam T  float/uint8_t/int64_t/Float16
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        template<typename T>
+        std::string ExecAsync(const Binding &binding, const std::vector<Tensor<T>> &input_datas, const ExecOptions &options)
+        {
+            return this->ExecAsync(binding, std::vector<Input>(input_datas.begin(), input_datas.end()), options);
+        }
+
+        template<typename T>
+        std::string ExecAsync(const Binding &binding, const std::vector<Tensor<T>> &input_datas)
+        {
+            return this->ExecAsync(binding, std::vector<Input>(input_datas.begin(), input_datas.end()), ExecOptions());
+        }
+
+        /**
+         * @brief    异步执行(每次临时创建绑定，频繁执行时应使用Prepare)
          * @param    input_name     输入名称
          * @param    output_name    输出名称
          * @param    input_data     输入参数
+         * @param    options        执行选项
          * @return   std::string
          * @author   CXS (chenxiangshu@outlook.com)
          * @date     2024-01-12
          */
-        virtual std::string ExecAsync(const std::vector<std::string>   &input_names,
-                                      const std::vector<std::string>   &output_names,
-                                      const std::vector<Tensor<float>> &input_datas) = 0;
+        std::string ExecAsync(const std::vector<std::string>   &input_names,
+                              const std::vector<std::string>   &output_names,
+                              const std::vector<Input>         &input_datas,
+                              const ExecOptions                &options)
+        {
+            Binding binding;
+            auto    err = this->Prepare(input_names, output_names, {}, binding);
+            if (err.empty())
+                return this->ExecAsync(binding, input_datas, options);
+            if (options.done) {
+                this->Notify(binding, input_datas, std::vector<Result>(), err, options.done, options.executor);
+            } else if (this->callback != nullptr) {
+                const std::vector<Result> tmp;
+                this->callback(this, input_names, Input::Floats(input_datas), output_names, tmp, this->callback_context, err);
+            }
+            return err;
+        }
+
+        std::string ExecAsync(const std::vector<std::string>   &input_names,
+                              const std::vector<std::string>   &output_names,
+                              const std::vector<Input>         &input_datas)
+        {
+            return this->ExecAsync(input_names, output_names, input_datas, ExecOptions());
+        }
+
+        /**
+         * @brief    异步执行(返回future)
+         * @param    binding        执行绑定
+         * @param    input_datas    输入参数
+         * @param    options        执行选项(done由内部设置；指定executor时在执行器中完成future)
+         * @return   std::future<Reply>
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::future<Reply> ExecFuture(const Binding                    &binding,
+                                      const std::vector<Input>         &input_datas,
+                                      ExecOptions                       options)
+        {
+            auto promise = std::make_shared<std::promise<Reply>>();
+            auto future  = promise->get_future();
+            options.done = [promise](const std::vector<Result> &outputs, const std::string &err) {
+                Reply reply;
+                reply.outputs = outputs;
+                reply.err     = err;
+                promise->set_value($(reply));
+            };
+            // 提交失败时done已经调用
+            this->ExecAsync(binding, input_datas, options);
+            return future;
+        }
+
+        std::future<Reply> ExecFuture(const Binding &binding, const std::vector<Input> &input_datas)
+        {
+            return this->ExecFuture(binding, input_datas, ExecOptions());
+        }
     };
 
     /**
@@ -146,5 +1091,132 @@ namespace AIMethod {
      * @date     2024-01-10
      */
     extern IRatiocinate *Ratiocinate_Create();
+
+#if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
+    /**
+     * @brief    模型注册表(所有模型共享运行环境和全局线程池，避免多个模型的线程池争抢CPU)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class IModelRegistry {
+    public:
+        /**
+         * @brief    全局参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            int  intra_op_threads = 0;       // 全局算子内线程数(0:默认)
+            int  inter_op_threads = 0;       // 全局算子间线程数(0:默认)
+            bool allow_spinning   = true;    // 线程空闲时自旋等待
+            bool denormal_as_zero = false;   // 非规格化浮点数按0处理
+            int  load_threads     = 0;       // 并行加载线程数(0:每个模型一个线程)
+        } Parameters;
+
+        /**
+         * @brief    模型
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            std::string              name;     // 模型名称
+            IRatiocinate::Parameters params;   // 模型参数(model_data为空时内存映射model文件)
+        } Model;
+
+        virtual ~IModelRegistry() = default;
+
+        /**
+         * @brief    并行加载模型
+         * @param    models         模型列表
+         * @return   std::string    错误信息(任意模型失败时本次加载的模型全部放弃)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual std::string Load(const std::vector<Model> &models) = 0;
+
+        /**
+         * @brief    获取推理接口(由注册表管理生命周期)
+         * @param    name           模型名称
+         * @return   IRatiocinate*  不存在时返回nullptr
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual IRatiocinate *Get(const std::string &name) = 0;
+
+        /**
+         * @brief    已加载的模型名称
+         * @return   strings
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual strings Names() = 0;
+    };
+
+    /**
+     * @brief    创建模型注册表
+     * @param    params         全局参数
+     * @param    err            错误信息
+     * @return   IModelRegistry*
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern IModelRegistry *ModelRegistry_Create(const IModelRegistry::Parameters &params, std::string &err);
+
+    /**
+     * @brief    检查调优参数
+     * @param    params         模型参数
+     * @return   std::string    错误信息(为空表示合法)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern std::string Ratiocinate_CheckTuning(const IRatiocinate::Parameters &params);
+
+    /**
+     * @brief    基准测试结果
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    typedef struct
+    {
+        std::string          name;        // 配置名称
+        IRatiocinate::Tuning tuning;      // 调优参数
+        double               avg_ms;      // 平均延时
+        double               p50_ms;      // 中位延时
+        double               p99_ms;      // 99%延时
+        double               max_ms;      // 最大延时
+        double               cpu_ms;      // 每次推理消耗的CPU时间
+        double               cpu_usage;   // CPU占用(CPU时间/墙上时间，1.0表示占满一个核)
+    } BenchmarkResult;
+
+    /**
+     * @brief    调优基准测试
+     * @param    params         基础参数
+     * @param    input_names    输入名称
+     * @param    output_names   输出名称
+     * @param    input_datas    输入数据
+     * @param    iterations     每个配置的测试次数
+     * @param    results        测试结果(第一项为基础参数，其余每项只改变一个调优参数)
+     * @return   std::string    错误信息
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern std::string Ratiocinate_Benchmark(const IRatiocinate::Parameters         &params,
+                                             const std::vector<std::string>         &input_names,
+                                             const std::vector<std::string>         &output_names,
+                                             const std::vector<IRatiocinate::Input> &input_datas,
+                                             int                                     iterations,
+                                             std::vector<BenchmarkResult>           &results);
+
+    /**
+     * @brief    基准测试报告
+     * @param    results        测试结果
+     * @return   std::string
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern std::string Ratiocinate_BenchmarkReport(const std::vector<BenchmarkResult> &results);
+#endif
 }   // namespace AIMethod
 #endif   // __Ratiocinate_HPP__
@@ -68,13 +68,21 @@ namespace AIMethod {
             std::vector<int>   indices;
             std::vector<float> update_confidences;
             cv::dnn::softNMSBoxes(boxs, confidences, update_confidences, confidence_threshold, nms_threshold, indices);
-            std::vector<TargetDetection::Result> rs;
-            auto                                &let = lets[k];
+            // 批量还原坐标
+            std::vector<float> restored;
             for (auto idx : indices) {
+                auto &b = boxs[idx];
+                restored.insert(restored.end(), {(float)b.x, (float)b.y, (float)b.width, (float)b.height});
+            }
+            lets[k].RestoreBoxes(restored.data(), indices.size(), 4, Tools::Letterbox::BOX_XYWH, restored.data());
+            std::vector<TargetDetection::Result> rs;
+            for (size_t n = 0; n < indices.size(); n++) {
+                auto                    idx = indices[n];
+                auto                    b   = restored.data() + n * 4;
                 TargetDetection::Result t;
                 t._index     = indexs[idx];
                 t._box       = boxs[idx];
-                t.box        = let.Restore(boxs[idx]);   // 还原坐标
+                t.box        = cv::Rect(b[0], b[1], b[2], b[3]);
                 t.classId    = classIds[idx];
                 t.confidence = confidences[idx];
                 rs.push_back(t);
@@ -83,4 +91,89 @@ namespace AIMethod {
         }
         return result;
     }
+
+    /**
+     * @brief    盒子是否被图块边界截断(贴近不在整图边缘上的图块边)
+     * @param    box            盒子(整图坐标)
+     * @param    tile           所在图块
+     * @param    image          整图区域
+     * @return   true           被截断
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    static bool IsCut(const cv::Rect &box, const cv::Rect &tile, const cv::Rect &image)
+    {
+        const int margin = 4;   // 检测框贴边的容差(像素)
+        if (tile.x > image.x && box.x <= tile.x + margin)
+            return true;
+        if (tile.y > image.y && box.y <= tile.y + margin)
+            return true;
+        if (tile.br().x < image.br().x && box.br().x >= tile.br().x - margin)
+            return true;
+        if (tile.br().y < image.br().y && box.br().y >= tile.br().y - margin)
+            return true;
+        return false;
+    }
+
+    std::vector<TargetDetection::Result> TargetDetection::MergeTiles(const std::vector<std::vector<TargetDetection::Result>> &results,
+                                                                     const std::vector<cv::Rect>                             &tiles) const
+    {
+        typedef struct
+        {
+            Result r;
+            size_t tile;   // 所在图块
+            bool   cut;    // 被图块边界截断
+        } Item;
+
+        // 图块覆盖整图，整图区域为所有图块的并集
+        cv::Rect image;
+        for (auto &tile : tiles)
+            image = image.area() == 0 ? tile : (image | tile);
+        std::vector<Item> all;
+        for (size_t k = 0; k < results.size() && k < tiles.size(); k++) {
+            for (auto &r : results[k]) {
+                Item item;
+                item.r = r;
+                item.r.box.x += tiles[k].x;
+                item.r.box.y += tiles[k].y;
+                item.tile = k;
+                item.cut  = IsCut(item.r.box, tiles[k], image);
+                all.push_back(item);
+            }
+        }
+        // 完整的盒子优先保留，再按置信度从高到低
+        std::stable_sort(all.begin(), all.end(), [](const Item &a, const Item &b) {
+            if (a.cut != b.cut)
+                return !a.cut;
+            return a.r.confidence > b.r.confidence;
+        });
+        std::vector<TargetDetection::Result> rs;
+        std::vector<bool>                    removed(all.size(), false);
+        for (size_t i = 0; i < all.size(); i++) {
+            if (removed[i])
+                continue;
+            rs.push_back(all[i].r);
+            for (size_t j = i + 1; j < all.size(); j++) {
+                // 同一图块内已做过NMS，只处理不同图块之间的重复
+                if (removed[j] || all[j].tile == all[i].tile || all[j].r.classId != all[i].r.classId)
+                    continue;
+                auto &a     = all[i].r.box;
+                auto &b     = all[j].r.box;
+                int   inter = (a & b).area();
+                if (inter <= 0)
+                    continue;
+                // 同一目标在两个图块中都完整
+                if (inter > nms_threshold * (a.area() + b.area() - inter)) {
+                    removed[j] = true;
+                    continue;
+                }
+                // 截断的部分盒子落在另一个盒子内(完整目标中嵌套的同类目标不受影响)
+                bool a_smaller = a.area() < b.area();
+                bool cut       = a_smaller ? all[i].cut : all[j].cut;
+                if (cut && inter > tile_threshold * std::min(a.area(), b.area()))
+                    removed[j] = true;
+            }
+        }
+        return rs;
+    }
 }   // namespace AIMethod
\ No newline at end of file
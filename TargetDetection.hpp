@@ -42,6 +42,7 @@ namespace AIMethod {
 
         float confidence_threshold = 0.25f;   // 置信度阈值
         float nms_threshold        = 0.2f;    // NMS算法阈值
+        float tile_threshold       = 0.5f;    // 跨图块去重阈值(交集/被截断的较小盒子面积)
 
         /**
          * @brief    Yolo检测
@@ -55,6 +56,20 @@ namespace AIMethod {
                                                                const std::vector<Tools::Letterbox> &lets,
                                                                int                                  nm = 0) const;
 
+        /**
+         * @brief    合并图块检测结果
+         * @note     盒子平移到整图坐标后，完整的盒子优先、再按置信度从高到低保留；只比较不同图块的同类别盒子，
+         *           IoU超过nms_threshold的视为重复；图块边缘截断的盒子只是完整目标的一部分，与完整盒子的IoU很小，
+         *           此时较小盒子被截断且交集超过其面积*tile_threshold的才视为重复，不会删除嵌套的完整目标
+         * @param    results        各图块的检测结果(Yolo)
+         * @param    tiles          图块区域(ImageTilesToNCHW)
+         * @return   std::vector<TargetDetection::Result>
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::vector<TargetDetection::Result> MergeTiles(const std::vector<std::vector<TargetDetection::Result>> &results,
+                                                        const std::vector<cv::Rect>                             &tiles) const;
+
         /**
          * @brief    画盒子
          * @param    img            图像
@@ -18,6 +18,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <atomic>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -33,6 +34,84 @@
 #include "Algorithm.hpp"
 
 namespace AIMethod {
+    /**
+     * @brief    半精度浮点(IEEE 754 binary16，仅用于存储和转换)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class Float16 {
+    public:
+        uint16_t bits = 0;
+
+        Float16() {}
+
+        Float16(float v) :
+            bits(FromFloat(v)) {}
+
+        operator float() const
+        {
+            return ToFloat(this->bits);
+        }
+
+        /**
+         * @brief    float转半精度(就近舍入到偶数，超出范围为无穷大)
+         * @param    v              值
+         * @return   uint16_t
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static uint16_t FromFloat(float v)
+        {
+            uint32_t x;
+            memcpy(&x, &v, sizeof(x));
+            uint16_t sign = (x >> 16) & 0x8000;
+            x &= 0x7FFFFFFF;
+            if (x >= 0x7F800000)   // 无穷大/NaN
+                return sign | 0x7C00 | (x > 0x7F800000 ? 0x0200 : 0);
+            if (x >= 0x477FF000)   // 溢出
+                return sign | 0x7C00;
+            if (x < 0x38800000) {
+                // 非规格化数: 加0.5使尾数对齐到半精度最小单位
+                float f;
+                memcpy(&f, &x, sizeof(f));
+                f += 0.5f;
+                memcpy(&x, &f, sizeof(x));
+                return sign | (uint16_t)(x - 0x3F000000);
+            }
+            // 指数偏移(127->15)，低13位就近舍入到偶数
+            x += 0xC8000FFF + ((x >> 13) & 1);
+            return sign | (uint16_t)(x >> 13);
+        }
+
+        /**
+         * @brief    半精度转float
+         * @param    h              值
+         * @return   float
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static float ToFloat(uint16_t h)
+        {
+            uint32_t x   = (uint32_t)(h & 0x7FFF) << 13;
+            uint32_t exp = x & 0x0F800000;
+            x += (127 - 15) << 23;
+            if (exp == 0x0F800000) {
+                x += (128 - 16) << 23;   // 无穷大/NaN
+            } else if (exp == 0) {
+                // 非规格化数
+                float f;
+                x += 1 << 23;
+                memcpy(&f, &x, sizeof(f));
+                f -= 6.103515625e-05f;   // 2^-14
+                memcpy(&x, &f, sizeof(x));
+            }
+            x |= (uint32_t)(h & 0x8000) << 16;
+            float f;
+            memcpy(&f, &x, sizeof(f));
+            return f;
+        }
+    };
+
     /**
      * @brief    张量
      * @tparam T
@@ -44,14 +123,24 @@ namespace AIMethod {
     private:
         class Node {
         public:
-            std::atomic<int> ref_count;
-            std::vector<T>   data;
+            std::atomic<int>      ref_count;
+            std::vector<T>        data;
+            std::function<void()> release;   // 外部数据释放(为空时数据保存在data)
 
             Node() :
                 ref_count(1) {}
 
             Node(const T *data, size_t size) :
                 ref_count(1), data(data, data + size) {}
+
+            Node(std::function<void()> release) :
+                ref_count(1), release(std::move(release)) {}
+
+            ~Node()
+            {
+                if (this->release)
+                    this->release();
+            }
         };
 
         Node            *node = nullptr;
@@ -231,6 +320,20 @@ namespace AIMethod {
             return tmp;
         }
 
+        /**
+         * @brief    引用外部数据（不会拷贝数据，最后一个引用释放时调用release）
+         * @param    shape          形状
+         * @param    data           数据指针
+         * @param    release        释放函数(可在任意线程调用)
+         * @return   Tensor
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static Tensor MakeExternal(const std::vector<int> &shape, T *data, std::function<void()> release)
+        {
+            return Tensor(shape, data, new Node(std::move(release)));
+        }
+
         /**
          * @brief    获取形状
          * @return   const std::vector<int>&
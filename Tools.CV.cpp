@@ -3,44 +3,390 @@
 
 namespace Tools {
     // --------------------------------------------------------------------------------
-    //                                Letterbox
+    //                                YUVImage
     // --------------------------------------------------------------------------------
 
-    cv::Mat Letterbox::Make(const cv::Mat &src, int h, int w, Letterbox &let)
+    // BT.601有限范围定点系数(与OpenCV一致)
+    static const int YUV_SHIFT = 20;
+    static const int YUV_CY    = 1220542;    // 1.164
+    static const int YUV_CUB   = 2116026;    // 2.018
+    static const int YUV_CUG   = -409993;    // -0.391
+    static const int YUV_CVG   = -852492;    // -0.813
+    static const int YUV_CVR   = 1673527;    // 1.596
+
+    static inline uint8_t YUVClamp(int v)
     {
-        int   in_w     = src.cols;   // width
-        int   in_h     = src.rows;   // height
-        int   tar_w    = w;
-        int   tar_h    = h;
-        float r        = std::min(float(tar_h) / in_h, float(tar_w) / in_w);
-        int   inside_w = round(in_w * r);
-        int   inside_h = round(in_h * r);
-        int   pad_w    = tar_w - inside_w;
-        int   pad_h    = tar_h - inside_h;
+        return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+    }
 
-        cv::Mat resize_img;
+    /**
+     * @brief    转换两个共享色度的像素
+     * @param    y0             像素0亮度
+     * @param    y1             像素1亮度
+     * @param    u              色度U
+     * @param    v              色度V
+     * @param    bgr            [out]BGR[6]
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    static inline void YUVPair(int y0, int y1, int u, int v, uint8_t *bgr)
+    {
+        u -= 128;
+        v -= 128;
+        int ruv   = (1 << (YUV_SHIFT - 1)) + YUV_CVR * v;
+        int guv   = (1 << (YUV_SHIFT - 1)) + YUV_CVG * v + YUV_CUG * u;
+        int buv   = (1 << (YUV_SHIFT - 1)) + YUV_CUB * u;
+        int ys[2] = {y0, y1};
+        for (int i = 0; i < 2; i++) {
+            int y          = std::max(0, ys[i] - 16) * YUV_CY;
+            bgr[i * 3 + 0] = YUVClamp((y + buv) >> YUV_SHIFT);
+            bgr[i * 3 + 1] = YUVClamp((y + guv) >> YUV_SHIFT);
+            bgr[i * 3 + 2] = YUVClamp((y + ruv) >> YUV_SHIFT);
+        }
+        return;
+    }
+
+    YUVImage YUVImage::FromMat(const cv::Mat &mat, Format format)
+    {
+        YUVImage img;
+        img.format = format;
+        if (format == FORMAT_YUYV) {
+            img.width   = mat.cols;
+            img.height  = mat.rows;
+            img.data[0] = mat.data;
+            img.step[0] = mat.step[0];
+            return img;
+        }
+        img.width   = mat.cols;
+        img.height  = mat.rows * 2 / 3;
+        img.data[0] = mat.data;
+        img.step[0] = mat.step[0];
+        img.data[1] = mat.data == nullptr ? nullptr : mat.data + img.height * mat.step[0];
+        img.step[1] = mat.step[0];
+        if (format == FORMAT_I420) {
+            // U、V平面各占h/4行，每行存放两行色度
+            img.step[1] = mat.step[0] / 2;
+            img.data[2] = img.data[1] == nullptr ? nullptr : img.data[1] + (size_t)img.height / 2 * img.step[1];
+            img.step[2] = img.step[1];
+        }
+        return img;
+    }
 
-        cv::resize(src, resize_img, cv::Size(inside_w, inside_h));
+    std::string YUVImage::Check() const
+    {
+        if (this->width <= 0 || this->height <= 0)
+            return "The picture cannot be empty";
+        if (this->width % 2 != 0 || (this->format != FORMAT_YUYV && this->height % 2 != 0))
+            return "The YUV picture size must be even";
+        int planes = this->format == FORMAT_YUYV ? 1 : (this->format == FORMAT_I420 ? 3 : 2);
+        for (int i = 0; i < planes; i++) {
+            if (this->data[i] == nullptr)
+                return "The YUV picture plane cannot be empty";
+        }
+        // 行跨度: 亮度/交织平面为宽度(YUYV为2倍)，I420色度平面为半宽
+        size_t min_step[3] = {(size_t)this->width, (size_t)this->width, 0};
+        if (this->format == FORMAT_YUYV)
+            min_step[0] = (size_t)this->width * 2;
+        if (this->format == FORMAT_I420)
+            min_step[1] = min_step[2] = (size_t)this->width / 2;
+        for (int i = 0; i < planes; i++) {
+            if (this->step[i] < min_step[i])
+                return "The YUV picture step is too small";
+        }
+        return std::string();
+    }
+
+    void YUVImage::ConvertRow(int y, uint8_t *bgr) const
+    {
+        int            w  = this->width;
+        const uint8_t *py = this->data[0] + (size_t)y * this->step[0];
+        switch (this->format) {
+            case FORMAT_NV12:
+            case FORMAT_NV21: {
+                const uint8_t *puv = this->data[1] + (size_t)(y / 2) * this->step[1];
+                int            iu  = this->format == FORMAT_NV12 ? 0 : 1;
+                for (int x = 0; x < w; x += 2)
+                    YUVPair(py[x], py[x + 1], puv[x + iu], puv[x + 1 - iu], bgr + x * 3);
+            } break;
+            case FORMAT_I420: {
+                const uint8_t *pu = this->data[1] + (size_t)(y / 2) * this->step[1];
+                const uint8_t *pv = this->data[2] + (size_t)(y / 2) * this->step[2];
+                for (int x = 0; x < w; x += 2)
+                    YUVPair(py[x], py[x + 1], pu[x / 2], pv[x / 2], bgr + x * 3);
+            } break;
+            case FORMAT_YUYV: {
+                for (int x = 0; x < w; x += 2) {
+                    const uint8_t *p = py + x * 2;
+                    YUVPair(p[0], p[2], p[1], p[3], bgr + x * 3);
+                }
+            } break;
+        }
+        return;
+    }
 
-        pad_w = pad_w / 2;
-        pad_h = pad_h / 2;
+    // --------------------------------------------------------------------------------
+    //                                Letterbox
+    // --------------------------------------------------------------------------------
 
-        let._fill_height = pad_h;
-        let._fill_width  = pad_w;
-        let._r           = r;
-        let.height       = in_h;
-        let.width        = in_w;
-        let.let_height   = h;
-        let.let_width    = w;
+    cv::Size Letterbox::Init(const cv::Size &src, int h, int w)
+    {
+        float r        = std::min(float(h) / src.height, float(w) / src.width);
+        int   inside_w = round(src.width * r);
+        int   inside_h = round(src.height * r);
 
-        int top    = int(round(pad_h - 0.1));
-        int bottom = int(round(pad_h + 0.1));
-        int left   = int(round(pad_w - 0.1));
-        int right  = int(round(pad_w + 0.1));
+        // 填充为奇数时多出的一行/列放在下/右，保证输出正好为目标大小
+        this->_fill_height = (h - inside_h) / 2;
+        this->_fill_width  = (w - inside_w) / 2;
+        this->_r           = r;
+        this->height       = src.height;
+        this->width        = src.width;
+        this->let_height   = h;
+        this->let_width    = w;
+        return cv::Size(inside_w, inside_h);
+    }
+
+    cv::Mat Letterbox::Make(const cv::Mat &src, int h, int w, Letterbox &let)
+    {
+        auto    inside = let.Init(src.size(), h, w);
+        cv::Mat resize_img;
+
+        cv::resize(src, resize_img, inside);
+
+        int top    = let._fill_height;
+        int bottom = h - inside.height - top;
+        int left   = let._fill_width;
+        int right  = w - inside.width - left;
         cv::copyMakeBorder(resize_img, resize_img, top, bottom, left, right, 0, cv::Scalar(114, 114, 114));
         return resize_img;
     }
 
+    /**
+     * @brief    双线性插值坐标表(像素中心对齐，与cv::resize一致)
+     * @param    in             源长度
+     * @param    out            目标长度
+     * @param    ofs            [out]左侧(上方)源像素
+     * @param    weight         [out]右侧(下方)源像素的权重
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    static void LinearTable(int in, int out, std::vector<int> &ofs, std::vector<float> &weight)
+    {
+        double scale = (double)in / out;
+        ofs.resize(out);
+        weight.resize(out);
+        for (int i = 0; i < out; i++) {
+            double f  = (i + 0.5) * scale - 0.5;
+            int    i0 = (int)floor(f);
+            float  a  = (float)(f - i0);
+            if (i0 < 0) {
+                i0 = 0;
+                a  = 0;
+            }
+            if (i0 >= in - 1) {
+                i0 = in - 1;
+                a  = 0;
+            }
+            ofs[i]    = i0;
+            weight[i] = a;
+        }
+        return;
+    }
+
+    /**
+     * @brief    水平插值一行(BGR交织 -> RGB平面)
+     * @note     按ofs[x]间接取源像素，编译器不会向量化，为标量循环；每个源行只插值一次，
+     *           相邻目标行复用结果，可向量化的是LetterboxNCHW中的垂直混合
+     * @param    src            源行
+     * @param    in_w           源宽度
+     * @param    ofs            坐标表
+     * @param    weight         权重表
+     * @param    w              目标宽度
+     * @param    dst            [out]目标行[3,w]
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    template<typename T>
+    static void LinearRow(const T *src, int in_w, const int *ofs, const float *weight, int w, float *dst)
+    {
+        float *__restrict r = dst;
+        float *__restrict g = dst + w;
+        float *__restrict b = dst + w * 2;
+        for (int x = 0; x < w; x++) {
+            const T *p0 = src + ofs[x] * 3;
+            const T *p1 = ofs[x] + 1 < in_w ? p0 + 3 : p0;
+            float    a  = weight[x];
+            b[x]        = (float)p0[0] + ((float)p1[0] - (float)p0[0]) * a;
+            g[x]        = (float)p0[1] + ((float)p1[1] - (float)p0[1]) * a;
+            r[x]        = (float)p0[2] + ((float)p1[2] - (float)p0[2]) * a;
+        }
+        return;
+    }
+
+    /**
+     * @brief    Letterbox并输出平面RGB(先水平插值到行缓存，相邻目标行复用，再垂直混合写入目标)
+     * @param    src            源图像大小
+     * @param    row            源行访问: const T *row(int y)，返回第y行BGR交织数据[src.width*3](下次调用前有效)
+     * @param    inside         缩放后的图像大小
+     * @param    top            上方填充
+     * @param    left           左侧填充
+     * @param    h              目标高度
+     * @param    w              目标宽度
+     * @param    scale          归一化系数
+     * @param    dst            [out]目标[3,h,w]
+     * @param    y_begin        处理的目标行[y_begin,y_end)
+     * @param    y_end          处理的目标行
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    template<typename T, typename Row>
+    static void LetterboxNCHW(const cv::Size &src,
+                              Row             row,
+                              const cv::Size &inside,
+                              int             top,
+                              int             left,
+                              int             h,
+                              int             w,
+                              float           scale,
+                              float          *dst,
+                              int             y_begin,
+                              int             y_end)
+    {
+        size_t plane     = (size_t)h * w;
+        float *planes[3] = {dst, dst + plane, dst + plane * 2};
+        float  fill      = 114 * scale;
+        int    right     = w - inside.width - left;
+        // 填充
+        for (int c = 0; c < 3; c++) {
+            for (int y = y_begin; y < y_end; y++) {
+                float *d = planes[c] + (size_t)y * w;
+                if (y < top || y >= top + inside.height) {
+                    std::fill(d, d + w, fill);
+                } else {
+                    std::fill(d, d + left, fill);
+                    std::fill(d + w - right, d + w, fill);
+                }
+            }
+        }
+        // 图像区域内的行
+        int begin = std::max(y_begin - top, 0);
+        int end   = std::min(y_end - top, inside.height);
+        // 大小不变时只做通道变换和归一化
+        if (inside == src) {
+            for (int y = begin; y < end; y++) {
+                const T *p          = row(y);
+                float *__restrict r = planes[0] + (size_t)(top + y) * w + left;
+                float *__restrict g = planes[1] + (size_t)(top + y) * w + left;
+                float *__restrict b = planes[2] + (size_t)(top + y) * w + left;
+                for (int x = 0; x < inside.width; x++) {
+                    r[x] = p[x * 3 + 2] * scale;
+                    g[x] = p[x * 3 + 1] * scale;
+                    b[x] = p[x * 3 + 0] * scale;
+                }
+            }
+            return;
+        }
+        std::vector<int>   xofs, yofs;
+        std::vector<float> xw, yw;
+        LinearTable(src.width, inside.width, xofs, xw);
+        LinearTable(src.height, inside.height, yofs, yw);
+        // 两个源行的水平插值结果
+        std::vector<float> rows(inside.width * 6);
+        float             *cache[2]   = {rows.data(), rows.data() + inside.width * 3};
+        int                cache_y[2] = {-1, -1};
+        for (int y = begin; y < end; y++) {
+            int y0 = yofs[y];
+            int y1 = std::min(y0 + 1, src.height - 1);
+            if (cache_y[0] != y0) {
+                if (cache_y[1] == y0) {
+                    std::swap(cache[0], cache[1]);
+                    std::swap(cache_y[0], cache_y[1]);
+                } else {
+                    LinearRow(row(y0), src.width, xofs.data(), xw.data(), inside.width, cache[0]);
+                    cache_y[0] = y0;
+                }
+            }
+            if (cache_y[1] != y1) {
+                LinearRow(row(y1), src.width, xofs.data(), xw.data(), inside.width, cache[1]);
+                cache_y[1] = y1;
+            }
+            float a0 = (1 - yw[y]) * scale;
+            float a1 = yw[y] * scale;
+            // 连续访问，可自动向量化
+            for (int c = 0; c < 3; c++) {
+                const float *__restrict s0 = cache[0] + c * inside.width;
+                const float *__restrict s1 = cache[1] + c * inside.width;
+                float *__restrict d        = planes[c] + (size_t)(top + y) * w + left;
+                for (int x = 0; x < inside.width; x++)
+                    d[x] = s0[x] * a0 + s1[x] * a1;
+            }
+        }
+        return;
+    }
+
+    Letterbox Letterbox::Create(const cv::Size &src, int h, int w)
+    {
+        Letterbox let;
+        let.Init(src, h, w);
+        return let;
+    }
+
+    cv::Size Letterbox::AutoSize(const std::vector<cv::Size> &srcs, int h, int w, int stride)
+    {
+        cv::Size size(0, 0);
+        stride = std::max(stride, 1);
+        for (auto &src : srcs) {
+            if (src.empty())
+                continue;
+            Letterbox let;
+            auto      inside = let.Init(src, h, w);
+            // 向上取整到步长(不超过最大目标大小)
+            size.width  = std::max(size.width, std::min((inside.width + stride - 1) / stride * stride, w));
+            size.height = std::max(size.height, std::min((inside.height + stride - 1) / stride * stride, h));
+        }
+        return size;
+    }
+
+    void Letterbox::MakeNCHW(const cv::Mat &src, int h, int w, float scale, float *dst, Letterbox &let)
+    {
+        let = Create(src.size(), h, w);
+        MakeNCHW(src, let, scale, dst, 0, h);
+        return;
+    }
+
+    void Letterbox::MakeNCHW(const cv::Mat &src, const Letterbox &let, float scale, float *dst, int y_begin, int y_end)
+    {
+        cv::Size inside(round(let.width * let._r), round(let.height * let._r));
+        int      h = let.let_height;
+        int      w = let.let_width;
+        y_begin    = std::max(y_begin, 0);
+        y_end      = std::min(y_end, h);
+        if (src.depth() == CV_8U) {
+            auto row = [&src](int y) { return src.ptr<uint8_t>(y); };
+            LetterboxNCHW<uint8_t>(src.size(), row, inside, let._fill_height, let._fill_width, h, w, scale, dst, y_begin, y_end);
+        } else {
+            auto row = [&src](int y) { return src.ptr<float>(y); };
+            LetterboxNCHW<float>(src.size(), row, inside, let._fill_height, let._fill_width, h, w, scale, dst, y_begin, y_end);
+        }
+        return;
+    }
+
+    void Letterbox::MakeNCHW(const YUVImage &src, const Letterbox &let, float scale, float *dst, int y_begin, int y_end)
+    {
+        cv::Size inside(round(let.width * let._r), round(let.height * let._r));
+        int      h = let.let_height;
+        int      w = let.let_width;
+        y_begin    = std::max(y_begin, 0);
+        y_end      = std::min(y_end, h);
+        // 按需逐行转换颜色(只转换用到的源行)
+        std::vector<uint8_t> buf((size_t)src.width * 3);
+        auto                 row = [&src, &buf](int y) {
+            src.ConvertRow(y, buf.data());
+            return (const uint8_t *)buf.data();
+        };
+        LetterboxNCHW<uint8_t>(src.Size(), row, inside, let._fill_height, let._fill_width, h, w, scale, dst, y_begin, y_end);
+        return;
+    }
+
     cv::Rect Letterbox::Restore(const cv::Rect &box) const
     {
         cv::Rect scaled_box;
@@ -70,6 +416,318 @@ namespace Tools {
         return r;
     }
 
+    void Letterbox::RestoreBoxes(const float *boxes, size_t count, size_t stride, BoxFormat format, float *out) const
+    {
+        // x' = (x - fill) / r = x * k + b
+        float k  = 1.0f / this->_r;
+        float bx = -this->_fill_width * k;
+        float by = -this->_fill_height * k;
+        float mw = (float)this->width;
+        float mh = (float)this->height;
+        float ws = format == BOX_XYWH ? 1.0f : 0.0f;   // 宽高转右下角
+        for (size_t i = 0; i < count; i++) {
+            const float *p  = boxes + i * stride;
+            float        x0 = p[0];
+            float        y0 = p[1];
+            float        x1 = p[2] + x0 * ws;
+            float        y1 = p[3] + y0 * ws;
+            x0              = std::min(std::max(x0 * k + bx, 0.0f), mw);
+            y0              = std::min(std::max(y0 * k + by, 0.0f), mh);
+            x1              = std::min(std::max(x1 * k + bx, 0.0f), mw);
+            y1              = std::min(std::max(y1 * k + by, 0.0f), mh);
+            float       *d  = out + i * 4;
+            d[0]            = x0;
+            d[1]            = y0;
+            d[2]            = x1 - x0 * ws;
+            d[3]            = y1 - y0 * ws;
+        }
+        return;
+    }
+
+    void Letterbox::RestorePoints(const float *pts, size_t count, size_t stride, float *out) const
+    {
+        float k  = 1.0f / this->_r;
+        float bx = -this->_fill_width * k;
+        float by = -this->_fill_height * k;
+        float mw = (float)this->width;
+        float mh = (float)this->height;
+        for (size_t i = 0; i < count; i++) {
+            float x        = pts[i * stride + 0];
+            float y        = pts[i * stride + 1];
+            out[i * 2 + 0] = std::min(std::max(x * k + bx, 0.0f), mw);
+            out[i * 2 + 1] = std::min(std::max(y * k + by, 0.0f), mh);
+        }
+        return;
+    }
+
+    void Letterbox::Rescale(const cv::Size &original)
+    {
+        if (this->width <= 0 || original.width <= 0)
+            return;
+        this->_r    *= (float)this->width / original.width;
+        this->width  = original.width;
+        this->height = original.height;
+        return;
+    }
+
+    // --------------------------------------------------------------------------------
+    //                                LetterboxMap
+    // --------------------------------------------------------------------------------
+
+    LetterboxMap::LetterboxMap(const cv::Size &src_size, size_t src_step, int h, int w, const Calibration *calib) :
+        let(Letterbox::Create(src_size, h, w)), src_size(src_size), src_step(src_step)
+    {
+        int      left = this->let._fill_width;
+        int      top  = this->let._fill_height;
+        float    r    = this->let._r;
+        cv::Size inside(round(src_size.width * r), round(src_size.height * r));
+        // 与cv::resize一致，按缩放后的实际大小分别计算两个方向的比例
+        double rx = (double)inside.width / src_size.width;
+        double ry = (double)inside.height / src_size.height;
+        // 目标像素->源坐标
+        this->undistort = calib != nullptr && !calib->camera_matrix.empty();
+        if (this->undistort) {
+            // 新内参: 去畸变后的图像按Letterbox缩放并平移(像素中心对齐)
+            cv::Mat K;
+            calib->camera_matrix.convertTo(K, CV_64F);
+            cv::Mat new_K          = K.clone();
+            new_K.at<double>(0, 0) = K.at<double>(0, 0) * rx;
+            new_K.at<double>(1, 1) = K.at<double>(1, 1) * ry;
+            new_K.at<double>(0, 2) = (K.at<double>(0, 2) + 0.5) * rx - 0.5 + left;
+            new_K.at<double>(1, 2) = (K.at<double>(1, 2) + 0.5) * ry - 0.5 + top;
+            cv::initUndistortRectifyMap(K, calib->dist_coeffs, cv::Mat(), new_K, cv::Size(w, h), CV_32FC1, this->map_x, this->map_y);
+        } else {
+            this->map_x.create(h, w, CV_32FC1);
+            this->map_y.create(h, w, CV_32FC1);
+            for (int y = 0; y < h; y++) {
+                float *mx = this->map_x.ptr<float>(y);
+                float *my = this->map_y.ptr<float>(y);
+                for (int x = 0; x < w; x++) {
+                    mx[x] = (float)((x - left + 0.5) / rx - 0.5);
+                    my[x] = (float)((y - top + 0.5) / ry - 0.5);
+                }
+            }
+        }
+        // 定点采样表(图像区域外填充，源坐标超出图像1个像素以上时填充)
+        int max_x = src_size.width - 1;
+        int max_y = src_size.height - 1;
+        this->table.resize((size_t)h * w);
+        for (int y = 0; y < h; y++) {
+            const float *mx = this->map_x.ptr<float>(y);
+            const float *my = this->map_y.ptr<float>(y);
+            for (int x = 0; x < w; x++) {
+                auto &e = this->table[(size_t)y * w + x];
+                e.ofs   = -1;
+                if (x < left || x >= left + inside.width || y < top || y >= top + inside.height)
+                    continue;
+                float sx = mx[x];
+                float sy = my[x];
+                if (sx < -1 || sy < -1 || sx > max_x + 1 || sy > max_y + 1)
+                    continue;
+                // 边缘复制，且右/下相邻像素始终在图像内
+                sx     = std::min(std::max(sx, 0.0f), (float)max_x);
+                sy     = std::min(std::max(sy, 0.0f), (float)max_y);
+                int x0 = std::min((int)sx, max_x - 1);
+                int y0 = std::min((int)sy, max_y - 1);
+                e.ofs  = (int32_t)(y0 * src_step + x0 * 3);
+                e.wx   = (uint16_t)lround((sx - x0) * 256);
+                e.wy   = (uint16_t)lround((sy - y0) * 256);
+            }
+        }
+        return;
+    }
+
+    std::shared_ptr<const LetterboxMap> LetterboxMap::Get(const cv::Mat &src, int h, int w, const Calibration *calib)
+    {
+        if (src.cols < 2 || src.rows < 2 || src.type() != CV_8UC3)
+            return nullptr;
+        static std::mutex                                                       mutex;
+        static std::list<std::pair<std::string, std::shared_ptr<LetterboxMap>>> cache;   // 最近使用的在前
+        const size_t                                                            max_cache = 16;
+        // 键: 大小、跨度、标定参数(按值)
+        std::string key = Tools::Format("{0}x{1}:{2}->{3}x{4}", src.cols, src.rows, src.step[0], w, h);
+        if (calib != nullptr && !calib->camera_matrix.empty()) {
+            cv::Mat K, D;
+            calib->camera_matrix.convertTo(K, CV_64F);
+            calib->dist_coeffs.convertTo(D, CV_64F);
+            K = K.reshape(1, 1).clone();
+            D = D.reshape(1, 1).clone();
+            key.append((const char *)K.data, K.total() * sizeof(double));
+            key.append((const char *)D.data, D.total() * sizeof(double));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = cache.begin(); it != cache.end(); ++it) {
+                if (it->first != key)
+                    continue;
+                if (it != cache.begin())
+                    cache.splice(cache.begin(), cache, it);
+                return cache.front().second;
+            }
+        }
+        // 在锁外创建(同时创建时重复计算，结果相同)
+        auto map = std::make_shared<LetterboxMap>(src.size(), src.step[0], h, w, calib);
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.push_front(std::make_pair(key, map));
+        if (cache.size() > max_cache)
+            cache.pop_back();
+        return map;
+    }
+
+    std::string LetterboxMap::MakeNCHW(const cv::Mat &src, float scale, float *dst, int y_begin, int y_end) const
+    {
+        if (src.type() != CV_8UC3)
+            return "The picture must be 8UC3";
+        if (src.size() != this->src_size || src.step[0] != this->src_step)
+            return "The picture does not match the map";
+        int    h         = this->let.let_height;
+        int    w         = this->let.let_width;
+        size_t plane     = (size_t)h * w;
+        float *planes[3] = {dst, dst + plane, dst + plane * 2};
+        float  k         = scale / 65536;
+        float  fill      = 114 * scale;
+        size_t step      = this->src_step;
+        y_begin          = std::max(y_begin, 0);
+        y_end            = std::min(y_end, h);
+        for (int y = y_begin; y < y_end; y++) {
+            const Entry *e = this->table.data() + (size_t)y * w;
+            float       *r = planes[0] + (size_t)y * w;
+            float       *g = planes[1] + (size_t)y * w;
+            float       *b = planes[2] + (size_t)y * w;
+            for (int x = 0; x < w; x++) {
+                if (e[x].ofs < 0) {
+                    r[x] = g[x] = b[x] = fill;
+                    continue;
+                }
+                const uint8_t *p  = src.data + e[x].ofs;
+                int            wx = e[x].wx;
+                int            wy = e[x].wy;
+                int            v[3];
+                for (int c = 0; c < 3; c++) {
+                    int t = p[c] * (256 - wx) + p[c + 3] * wx;
+                    int d = p[step + c] * (256 - wx) + p[step + c + 3] * wx;
+                    v[c]  = t * (256 - wy) + d * wy;
+                }
+                b[x] = v[0] * k;
+                g[x] = v[1] * k;
+                r[x] = v[2] * k;
+            }
+        }
+        return std::string();
+    }
+
+    cv::Point2f LetterboxMap::Restore(const cv::Point2f &pt) const
+    {
+        cv::Point2f rs;
+        if (!this->undistort) {
+            // 无畸变时直接反算
+            rs.x = (pt.x - this->let._fill_width) / this->let._r;
+            rs.y = (pt.y - this->let._fill_height) / this->let._r;
+        } else {
+            // 查映射表(双线性，映射表按像素中心采样)
+            float x  = std::min(std::max(pt.x - 0.5f, 0.0f), (float)(this->map_x.cols - 1));
+            float y  = std::min(std::max(pt.y - 0.5f, 0.0f), (float)(this->map_x.rows - 1));
+            int   x0 = std::min((int)x, this->map_x.cols - 2 < 0 ? 0 : this->map_x.cols - 2);
+            int   y0 = std::min((int)y, this->map_x.rows - 2 < 0 ? 0 : this->map_x.rows - 2);
+            int   x1 = std::min(x0 + 1, this->map_x.cols - 1);
+            int   y1 = std::min(y0 + 1, this->map_x.rows - 1);
+            float ax = x - x0;
+            float ay = y - y0;
+            auto  at = [&](const cv::Mat &m) {
+                float t = m.at<float>(y0, x0) * (1 - ax) + m.at<float>(y0, x1) * ax;
+                float d = m.at<float>(y1, x0) * (1 - ax) + m.at<float>(y1, x1) * ax;
+                return t * (1 - ay) + d * ay;
+            };
+            rs.x = at(this->map_x) + 0.5f;
+            rs.y = at(this->map_y) + 0.5f;
+        }
+        rs.x = std::min(std::max(rs.x, 0.0f), (float)this->src_size.width);
+        rs.y = std::min(std::max(rs.y, 0.0f), (float)this->src_size.height);
+        return rs;
+    }
+
+    cv::Point LetterboxMap::Restore(const cv::Point &pt) const
+    {
+        auto rs = this->Restore(cv::Point2f(pt.x, pt.y));
+        return cv::Point(rs.x, rs.y);
+    }
+
+    cv::Rect LetterboxMap::Restore(const cv::Rect &box) const
+    {
+        if (!this->undistort)
+            return this->let.Restore(box);
+        // 去畸变后矩形在源图像中不再是矩形，取四个角的外接矩形
+        cv::Point2f pts[4] = {this->Restore(cv::Point2f(box.x, box.y)),
+                              this->Restore(cv::Point2f(box.x + box.width, box.y)),
+                              this->Restore(cv::Point2f(box.x, box.y + box.height)),
+                              this->Restore(cv::Point2f(box.x + box.width, box.y + box.height))};
+        float       x0     = std::min(std::min(pts[0].x, pts[1].x), std::min(pts[2].x, pts[3].x));
+        float       y0     = std::min(std::min(pts[0].y, pts[1].y), std::min(pts[2].y, pts[3].y));
+        float       x1     = std::max(std::max(pts[0].x, pts[1].x), std::max(pts[2].x, pts[3].x));
+        float       y1     = std::max(std::max(pts[0].y, pts[1].y), std::max(pts[2].y, pts[3].y));
+        return cv::Rect(cv::Point(x0, y0), cv::Point(x1, y1));
+    }
+
+    // --------------------------------------------------------------------------------
+    //                                ImageReader
+    // --------------------------------------------------------------------------------
+
+    ImageReader::ImageReader(const strings &files, int threads, int prefetch, const cv::Size2i &size) :
+        files(files), size(size), prefetch(std::max(prefetch, 1)), pool(threads)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->Fill();
+    }
+
+    void ImageReader::Fill()
+    {
+        // 已加锁
+        while (this->posted < this->files.size() && this->posted < this->next + this->prefetch) {
+            size_t index = this->posted++;
+            if (!this->pool.Post([this, index] { this->Load(index); }))
+                break;
+        }
+        return;
+    }
+
+    void ImageReader::Load(size_t index)
+    {
+        Frame frame;
+        frame.index = index;
+        frame.path  = this->files[index];
+        // 解码异常时返回空图像，保证每个序号都有结果(否则Next一直等待)
+        try {
+            if (this->size.empty()) {
+                frame.img      = cv::imread(frame.path);
+                frame.original = frame.img.size();
+            } else {
+                frame.img = ImageReadReduced(frame.path, this->size, frame.original);
+            }
+        }
+        catch (std::exception &) {
+            frame.img      = cv::Mat();
+            frame.original = cv::Size();
+        }
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->ready[index] = $(frame);
+        this->cond.notify_all();
+        return;
+    }
+
+    bool ImageReader::Next(Frame &frame)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (this->next >= this->files.size())
+            return false;
+        this->cond.wait(lock, [this] { return this->ready.count(this->next) != 0; });
+        auto it = this->ready.find(this->next);
+        frame   = $(it->second);
+        this->ready.erase(it);
+        this->next++;
+        this->Fill();
+        return true;
+    }
+
     void IMGProcess::AdaptiveHistogramEqualization(const cv::Mat    &src,
                                                    cv::Mat          &out,
                                                    int               limit,
@@ -159,49 +817,371 @@ namespace Tools {
         return dst;
     }
 
+    /**
+     * @brief    分块执行(每张图片一个任务，图片少于线程数时按行分块；当前线程参与处理并等待所有块完成)
+     * @note     块由当前线程和执行器任务共同领取: 执行器繁忙(包括当前线程就是执行器的工作线程)时，
+     *           未开始的块由当前线程处理，只等待其他线程已领取的块，不会死锁
+     * @param    count          图片数量
+     * @param    height         目标高度
+     * @param    executor       执行器(为空时在当前线程执行)
+     * @param    fn             处理函数(图片序号, 目标行[y_begin,y_end))
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    static void RunBlocks(size_t count, int height, Tools::IExecutor *executor, const std::function<void(size_t, int, int)> &fn)
+    {
+        typedef struct
+        {
+            size_t idx;
+            int    y_begin;
+            int    y_end;
+        } Block;
+        // 执行器任务可能在本函数返回后才开始，共享状态由任务持有；此时已没有可领取的块，不会访问fn
+        class Shared {
+        public:
+            std::vector<Block>                           blocks;
+            std::atomic<size_t>                          next;   // 下一个未领取的块
+            size_t                                       done;   // 已完成的块
+            std::mutex                                   mutex;
+            std::condition_variable                      cond;
+            const std::function<void(size_t, int, int)> *fn;
+
+            Shared() :
+                next(0), done(0), fn(nullptr) {}
+
+            void Run()
+            {
+                size_t i;
+                while ((i = this->next.fetch_add(1)) < this->blocks.size()) {
+                    auto &blk = this->blocks[i];
+                    (*this->fn)(blk.idx, blk.y_begin, blk.y_end);
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    if (++this->done == this->blocks.size())
+                        this->cond.notify_all();
+                }
+                return;
+            }
+        };
+        std::vector<Block> blocks;
+        int                bands = 1;
+        if (executor != nullptr && count > 0) {
+            int threads = std::max((int)std::thread::hardware_concurrency(), 1);
+            bands       = std::max(threads / (int)count, 1);
+            bands       = std::min(bands, std::max(height / 32, 1));   // 每块至少32行
+        }
+        for (size_t i = 0; i < count; i++) {
+            for (int b = 0; b < bands; b++)
+                blocks.push_back({i, height * b / bands, height * (b + 1) / bands});
+        }
+        if (executor == nullptr || blocks.size() <= 1) {
+            for (auto &blk : blocks)
+                fn(blk.idx, blk.y_begin, blk.y_end);
+            return;
+        }
+        auto shared    = std::make_shared<Shared>();
+        shared->blocks = $(blocks);
+        shared->fn     = &fn;
+        // 提交失败时剩余块由当前线程处理
+        for (size_t i = 1; i < shared->blocks.size(); i++) {
+            if (!executor->Post([shared] { shared->Run(); }))
+                break;
+        }
+        shared->Run();
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->cond.wait(lock, [&shared] { return shared->done == shared->blocks.size(); });
+        return;
+    }
+
+    std::string ImageBGRToNCHW(const std::vector<cv::Mat>    &imgs,
+                               const cv::Size2i              &size,
+                               float                         *dst,
+                               std::vector<Tools::Letterbox> &lets,
+                               float                          scale,
+                               Tools::IExecutor              *executor)
+    {
+        std::vector<cv::Mat> srcs(imgs.size());
+        for (size_t i = 0; i < imgs.size(); i++) {
+            auto &img = srcs[i];
+            img       = imgs[i];
+            if (img.size().empty())
+                return "The picture cannot be empty";
+            if (img.channels() != 3)
+                return "The picture must be 3 channels";
+            // uint8直接处理(数据量是float的1/4)，其他类型先转float
+            if (img.type() != CV_8UC3 && img.type() != CV_32FC3)
+                imgs[i].convertTo(img, CV_32FC3);
+            if (img.type() != CV_8UC3 && img.type() != CV_32FC3)
+                return "Image data type conversion failed. Procedure";
+        }
+        // 变换信息按图片顺序输出
+        size_t base = lets.size();
+        for (auto &img : srcs)
+            lets.push_back(Tools::Letterbox::Create(img.size(), size.height, size.width));
+        size_t block_size = (size_t)size.height * size.width * 3;
+        RunBlocks(srcs.size(), size.height, executor, [&](size_t idx, int y_begin, int y_end) {
+            Tools::Letterbox::MakeNCHW(srcs[idx], lets[base + idx], scale, dst + idx * block_size, y_begin, y_end);
+        });
+        return std::string();
+    }
+
     AIMethod::Tensor<float> ImageBGRToNCHW(const std::vector<cv::Mat>    &imgs,
                                            const cv::Size2i              &size,
                                            std::vector<Tools::Letterbox> &lets,
-                                           std::string                   &err)
+                                           std::string                   &err,
+                                           float                          scale,
+                                           Tools::IExecutor              *executor)
+    {
+        std::vector<float> tmp(imgs.size() * size.height * size.width * 3);
+        err = ImageBGRToNCHW(imgs, size, tmp.data(), lets, scale, executor);
+        if (!err.empty())
+            return AIMethod::Tensor<float>();
+        return AIMethod::Tensor<float>({(int)imgs.size(), 3, size.height, size.width}, std::move(tmp));
+    }
+
+    AIMethod::Tensor<float> ImageBGRToNCHWAuto(const std::vector<cv::Mat>    &imgs,
+                                               const cv::Size2i              &size,
+                                               int                            stride,
+                                               std::vector<Tools::Letterbox> &lets,
+                                               std::string                   &err,
+                                               float                          scale,
+                                               Tools::IExecutor              *executor)
+    {
+        std::vector<cv::Size> srcs;
+        for (auto &img : imgs)
+            srcs.push_back(img.size());
+        auto target = Tools::Letterbox::AutoSize(srcs, size.height, size.width, stride);
+        // 没有图片或全部为空时目标大小为0x0
+        if (target.empty()) {
+            err = "The picture cannot be empty";
+            return AIMethod::Tensor<float>();
+        }
+        return ImageBGRToNCHW(imgs, target, lets, err, scale, executor);
+    }
+
+    /**
+     * @brief    单方向划分图块
+     * @param    len            图像长度
+     * @param    tile           图块长度
+     * @param    overlap        重叠比例
+     * @param    pos            [out]图块起点
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    static void TileAxis(int len, int tile, float overlap, std::vector<int> &pos)
+    {
+        pos.clear();
+        if (len <= tile) {
+            pos.push_back(0);
+            return;
+        }
+        // 步长不超过图块长度*(1-重叠比例)，图块数量确定后均匀分布
+        int stride = std::max((int)(tile * (1 - overlap)), 1);
+        int count  = (len - tile + stride - 1) / stride + 1;
+        for (int i = 0; i < count; i++)
+            pos.push_back((int)((int64_t)(len - tile) * i / (count - 1)));
+        return;
+    }
+
+    std::vector<cv::Rect> SplitTiles(const cv::Size &src, const cv::Size2i &size, float overlap)
+    {
+        std::vector<cv::Rect> tiles;
+        std::vector<int>      xs, ys;
+        overlap = std::min(std::max(overlap, 0.0f), 0.9f);
+        TileAxis(src.width, size.width, overlap, xs);
+        TileAxis(src.height, size.height, overlap, ys);
+        for (auto y : ys) {
+            for (auto x : xs)
+                tiles.push_back(cv::Rect(x, y, std::min(size.width, src.width), std::min(size.height, src.height)));
+        }
+        return tiles;
+    }
+
+    AIMethod::Tensor<float> ImageTilesToNCHW(const cv::Mat                 &img,
+                                             const cv::Size2i              &size,
+                                             float                          overlap,
+                                             bool                           full_frame,
+                                             std::vector<cv::Rect>         &tiles,
+                                             std::vector<Tools::Letterbox> &lets,
+                                             std::string                   &err,
+                                             float                          scale,
+                                             Tools::IExecutor              *executor)
+    {
+        if (img.empty()) {
+            err = "The picture cannot be empty";
+            return AIMethod::Tensor<float>();
+        }
+        auto rects = SplitTiles(img.size(), size, overlap);
+        if (full_frame && rects.size() > 1)
+            rects.push_back(cv::Rect(0, 0, img.cols, img.rows));
+        std::vector<cv::Mat> crops;
+        for (auto &rect : rects)
+            crops.push_back(img(rect));   // 引用源图像
+        auto inputs = ImageBGRToNCHW(crops, size, lets, err, scale, executor);
+        if (!err.empty())
+            return inputs;
+        tiles.insert(tiles.end(), rects.begin(), rects.end());
+        return inputs;
+    }
+
+    std::string YUVToNCHW(const std::vector<YUVImage>   &imgs,
+                          const cv::Size2i              &size,
+                          float                         *dst,
+                          std::vector<Tools::Letterbox> &lets,
+                          float                          scale,
+                          Tools::IExecutor              *executor)
     {
-        int                block_size = size.height * size.width * 3;
-        std::vector<float> tmp(imgs.size() * block_size);
-        cv::Mat            img_f32;
+        for (auto &img : imgs) {
+            auto err = img.Check();
+            if (!err.empty())
+                return err;
+        }
+        size_t base = lets.size();
+        for (auto &img : imgs)
+            lets.push_back(Tools::Letterbox::Create(img.Size(), size.height, size.width));
+        size_t block_size = (size_t)size.height * size.width * 3;
+        RunBlocks(imgs.size(), size.height, executor, [&](size_t idx, int y_begin, int y_end) {
+            Tools::Letterbox::MakeNCHW(imgs[idx], lets[base + idx], scale, dst + idx * block_size, y_begin, y_end);
+        });
+        return std::string();
+    }
+
+    AIMethod::Tensor<float> YUVToNCHW(const std::vector<YUVImage>   &imgs,
+                                      const cv::Size2i              &size,
+                                      std::vector<Tools::Letterbox> &lets,
+                                      std::string                   &err,
+                                      float                          scale,
+                                      Tools::IExecutor              *executor)
+    {
+        std::vector<float> tmp(imgs.size() * size.height * size.width * 3);
+        err = YUVToNCHW(imgs, size, tmp.data(), lets, scale, executor);
+        if (!err.empty())
+            return AIMethod::Tensor<float>();
+        return AIMethod::Tensor<float>({(int)imgs.size(), 3, size.height, size.width}, std::move(tmp));
+    }
+
+    AIMethod::Tensor<uint8_t> ImageBGRToNHWC(const std::vector<cv::Mat>    &imgs,
+                                             const cv::Size2i              &size,
+                                             std::vector<Tools::Letterbox> &lets,
+                                             std::string                   &err)
+    {
+        std::vector<cv::Mat> tmp;
         for (size_t i = 0; i < imgs.size(); i++) {
-            auto   img  = imgs[i];
-            float *data = tmp.data() + i * block_size;
+            auto img = imgs[i];
             if (img.size().empty()) {
                 err = "The picture cannot be empty";
-                return AIMethod::Tensor<float>();
-            }
-            if (img.type() != CV_32FC3) {
-                img.convertTo(img_f32, CV_32FC3);   // 转float
-                img = img_f32;
+                return AIMethod::Tensor<uint8_t>();
             }
-            if (img.channels() != 3) {
-                err = "The picture must be 3 channels";
-                return AIMethod::Tensor<float>();
+            if (img.type() != CV_8UC3) {
+                err = "The picture must be 8UC3";
+                return AIMethod::Tensor<uint8_t>();
             }
-            if (img.type() != CV_32FC3) {
-                err = "Image data type conversion failed. Procedure";
-                return AIMethod::Tensor<float>();
-            }
-            // 图像变换
+            // 在uint8上做图像变换，数据量是float的1/4
             Tools::Letterbox let;
             if (img.size() != size)
                 img = Tools::Letterbox::Make(img, size.height, size.width, let);
             lets.push_back(let);
-            // BGR2RGB
-            for (int i = 0; i < img.rows; i++) {
-                for (int j = 0; j < img.cols; j++) {
-                    auto &tmp                                        = img.at<cv::Vec3f>(i, j);
-                    data[i * img.cols + j + 0]                       = tmp[2];
-                    data[i * img.cols + j + 1 * img.cols * img.rows] = tmp[1];
-                    data[i * img.cols + j + 2 * img.cols * img.rows] = tmp[0];
+            tmp.push_back(img);
+        }
+        std::vector<int> shape = {(int)imgs.size(), size.height, size.width, 3};
+        // 单张连续图像直接引用图像数据，不拷贝
+        if (tmp.size() == 1 && tmp[0].isContinuous()) {
+            auto img = tmp[0];
+            return AIMethod::Tensor<uint8_t>::MakeExternal(shape, img.data, [img] {});
+        }
+        size_t               row_size   = size.width * 3;
+        size_t               block_size = size.height * row_size;
+        std::vector<uint8_t> data(tmp.size() * block_size);
+        for (size_t i = 0; i < tmp.size(); i++) {
+            for (int r = 0; r < size.height; r++)
+                memcpy(data.data() + i * block_size + r * row_size, tmp[i].ptr<uint8_t>(r), row_size);
+        }
+        return AIMethod::Tensor<uint8_t>(shape, std::move(data));
+    }
+
+    /**
+     * @brief    解析JPEG图像大小(SOF段)
+     * @param    buf            文件数据
+     * @param    size           [out]图像大小
+     * @return   true           是JPEG且解析成功
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    static bool JpegSize(const std::vector<uint8_t> &buf, cv::Size &size)
+    {
+        if (buf.size() < 4 || buf[0] != 0xFF || buf[1] != 0xD8)
+            return false;
+        size_t i = 2;
+        while (i + 4 <= buf.size()) {
+            if (buf[i] != 0xFF)
+                return false;
+            uint8_t marker = buf[i + 1];
+            if (marker == 0xFF) {   // 填充
+                i++;
+                continue;
+            }
+            if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {   // 无长度的段
+                i += 2;
+                continue;
+            }
+            if (marker == 0xD9 || marker == 0xDA)   // 图像结束/扫描开始前未找到SOF
+                return false;
+            // SOF0~SOF15(不含DHT、JPG、DAC): 长度(2) 精度(1) 高(2) 宽(2)
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                if (i + 9 > buf.size())
+                    return false;
+                size.height = (buf[i + 5] << 8) | buf[i + 6];
+                size.width  = (buf[i + 7] << 8) | buf[i + 8];
+                return size.width > 0 && size.height > 0;
+            }
+            i += 2 + ((buf[i + 2] << 8) | buf[i + 3]);
+        }
+        return false;
+    }
+
+    cv::Mat ImageReadReduced(const std::string &path, const cv::Size2i &size, cv::Size &original)
+    {
+        std::vector<uint8_t> buf;
+        FILE                *fp = fopen(path.c_str(), "rb");
+        if (fp == nullptr)
+            return cv::Mat();
+        fseek(fp, 0, SEEK_END);
+        long len = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+        if (len > 0) {
+            buf.resize(len);
+            if (fread(buf.data(), 1, len, fp) != (size_t)len)
+                buf.clear();
+        }
+        fclose(fp);
+        if (buf.empty())
+            return cv::Mat();
+        // 选择缩小倍数: 解码尺寸不小于Letterbox缩放后的大小
+        static const int flags[4] = {cv::IMREAD_COLOR, cv::IMREAD_REDUCED_COLOR_2, cv::IMREAD_REDUCED_COLOR_4, cv::IMREAD_REDUCED_COLOR_8};
+        cv::Size         jpeg;
+        int              level = 0;
+        if (JpegSize(buf, jpeg)) {
+            float r        = std::min(float(size.height) / jpeg.height, float(size.width) / jpeg.width);
+            int   inside_w = round(jpeg.width * r);
+            int   inside_h = round(jpeg.height * r);
+            for (int k = 3; k > 0; k--) {
+                int n = 1 << k;
+                if ((jpeg.width + n - 1) / n >= inside_w && (jpeg.height + n - 1) / n >= inside_h) {
+                    level = k;
+                    break;
                 }
             }
         }
-        return AIMethod::Tensor<float>({(int)imgs.size(), 3, size.height, size.width}, std::move(tmp));
+        cv::Mat img = cv::imdecode(buf, flags[level]);
+        if (img.empty())
+            return img;
+        original = img.size();
+        if (level > 0) {
+            // EXIF方向旋转后宽高交换
+            original = jpeg;
+            if (jpeg.width != jpeg.height && (img.cols > img.rows) != (jpeg.width > jpeg.height))
+                std::swap(original.width, original.height);
+        }
+        return img;
     }
 
     // --------------------------------------------------------------------------------
@@ -2,7 +2,7 @@
  * @file     Tools.CV.hpp
  * @brief    OpenCV工具
  * @author   CXS (chenxiangshu@outlook.com)
- * @version  1.1
+ * @version  1.2
  * @date     2024-01-08
  *
  * @copyright Copyright (c) 2024  Four-Faith
@@ -12,14 +12,71 @@
  * <tr><th>日期       <th>版本    <th>作者    <th>说明
  * <tr><td>2024-01-08 <td>1.0     <td>CXS     <td>创建
  * <tr><td>2024-01-17 <td>1.1     <td>CXS     <td>修正Letterbox::Restore越界错误
+ * <tr><td>2026-10-18 <td>1.2     <td>CXS     <td>修正Letterbox::Make填充为奇数时输出尺寸差一像素
  * </table>
  */
 #if !defined(__Tools_CV_hpp__)
 #define __Tools_CV_hpp__
 #include "Tools.hpp"
+#include "Tools.Thread.hpp"
 #include <opencv4/opencv2/opencv.hpp>
+#include <climits>
+#include <list>
+#include <map>
 
 namespace Tools {
+    /**
+     * @brief    YUV图像(引用外部平面数据，不拷贝)
+     * @note     颜色转换与OpenCV的COLOR_YUV2BGR_*一致(BT.601，有限范围)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class YUVImage {
+    public:
+        typedef enum
+        {
+            FORMAT_NV12 = 0,   // Y平面 + UV交织平面(色度半宽半高)
+            FORMAT_NV21 = 1,   // Y平面 + VU交织平面(色度半宽半高)
+            FORMAT_I420 = 2,   // Y、U、V三个平面(色度半宽半高)
+            FORMAT_YUYV = 3,   // Y0 U Y1 V 交织(色度半宽)
+        } Format;
+
+        Format         format  = FORMAT_NV12;
+        int            width   = 0;
+        int            height  = 0;
+        const uint8_t *data[3] = {nullptr, nullptr, nullptr};   // 平面数据
+        size_t         step[3] = {0, 0, 0};                     // 平面行跨度(字节)
+
+        /**
+         * @brief    引用OpenCV格式的YUV图像
+         * @param    mat            NV12/NV21/I420: 8UC1[h*3/2,w](I420需连续)  YUYV: 8UC2[h,w]
+         * @param    format         格式
+         * @return   YUVImage
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static YUVImage FromMat(const cv::Mat &mat, Format format);
+
+        /**
+         * @brief    检查参数
+         * @return   std::string    错误信息
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string Check() const;
+
+        /**
+         * @brief    转换一行为BGR
+         * @param    y              行
+         * @param    bgr            [out]BGR数据[width*3]
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void ConvertRow(int y, uint8_t *bgr) const;
+
+        inline cv::Size Size() const { return cv::Size(this->width, this->height); }
+    };
+
     /**
      * @brief    图像Letterbox处理
      * @author   CXS (chenxiangshu@outlook.com)
@@ -31,6 +88,19 @@ namespace Tools {
         int   _fill_height = 0;
         float _r           = 1.0f;
 
+        /**
+         * @brief    计算变换参数
+         * @param    src            源图像大小
+         * @param    h              目标高度
+         * @param    w              目标宽度
+         * @return   cv::Size       缩放后的图像大小(不含填充)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        cv::Size Init(const cv::Size &src, int h, int w);
+
+        friend class LetterboxMap;
+
     public:
         int width;        // 原图像
         int height;       // 原图像
@@ -39,6 +109,7 @@ namespace Tools {
 
         /**
          * @brief    图像Letterbox处理
+         * @note     输出正好为h*w，填充为奇数时多出的一行/列放在下/右
          * @param    src            源图像
          * @param    h              目标高度
          * @param    w              目标宽度
@@ -64,6 +135,72 @@ namespace Tools {
             return Make(src, h, w, let);
         }
 
+        /**
+         * @brief    图像Letterbox处理并转换为平面RGB浮点数据
+         * @note     缩放、填充、BGR转RGB、归一化、HWC转CHW一次完成，不产生中间图像；
+         *           直接在源数据类型上双线性插值(像素中心对齐方式与cv::resize一致，uint8时结果误差在1以内)
+         * @param    src            源图像      [8UC3/32FC3:BGR]
+         * @param    h              目标高度
+         * @param    w              目标宽度
+         * @param    scale          归一化系数(输出=像素值*scale)
+         * @param    dst            [out]输出   [3,h,w:RGB]
+         * @param    let            变换信息
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static void MakeNCHW(const cv::Mat &src, int h, int w, float scale, float *dst, Letterbox &let);
+
+        /**
+         * @brief    按已计算的变换信息处理部分目标行(用于多线程分块处理同一图像)
+         * @param    src            源图像      [8UC3/32FC3:BGR]
+         * @param    let            变换信息(Create)
+         * @param    scale          归一化系数
+         * @param    dst            [out]输出   [3,let_height,let_width:RGB]
+         * @param    y_begin        目标行[y_begin,y_end)
+         * @param    y_end          目标行
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static void MakeNCHW(const cv::Mat &src, const Letterbox &let, float scale, float *dst, int y_begin, int y_end);
+
+        /**
+         * @brief    YUV图像按已计算的变换信息处理部分目标行(逐行转换颜色，不生成BGR图像)
+         * @param    src            源图像(已检查)
+         * @param    let            变换信息(Create)
+         * @param    scale          归一化系数
+         * @param    dst            [out]输出   [3,let_height,let_width:RGB]
+         * @param    y_begin        目标行[y_begin,y_end)
+         * @param    y_end          目标行
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static void MakeNCHW(const YUVImage &src, const Letterbox &let, float scale, float *dst, int y_begin, int y_end);
+
+        /**
+         * @brief    计算变换信息(不处理图像)
+         * @param    src            源图像大小
+         * @param    h              目标高度
+         * @param    w              目标宽度
+         * @return   Letterbox
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static Letterbox Create(const cv::Size &src, int h, int w);
+
+        /**
+         * @brief    计算最小填充的目标大小(自动模式)
+         * @note     按最大目标大小缩放后只填充到步长的整数倍(如16:9图像640x640 -> 640x384)；
+         *           批量时取能容纳所有图像的最小公共大小，缩放比例与填充到最大目标大小时相同
+         * @param    srcs           源图像大小
+         * @param    h              最大目标高度
+         * @param    w              最大目标宽度
+         * @param    stride         步长(模型最大下采样倍数)
+         * @return   cv::Size       目标大小(不超过最大目标大小，没有非空图像时为0x0)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static cv::Size AutoSize(const std::vector<cv::Size> &srcs, int h, int w, int stride = 32);
+
         /**
          * @brief    还原坐标
          * @param    box            图像盒子
@@ -73,6 +210,190 @@ namespace Tools {
          */
         cv::Rect  Restore(const cv::Rect &box) const;
         cv::Point Restore(const cv::Point &pt) const;
+
+        typedef enum
+        {
+            BOX_XYXY = 0,   // 左上、右下
+            BOX_XYWH = 1,   // 左上、宽高
+        } BoxFormat;
+
+        /**
+         * @brief    批量还原盒子(浮点精度，乘预计算的倒数，限制在图像内)
+         * @param    boxes          盒子       [count,stride]，每行前4个值为盒子
+         * @param    count          数量
+         * @param    stride         行跨度(不小于4)
+         * @param    format         盒子格式(输入输出相同)
+         * @param    out            [out]输出   [count,4]，可与boxes相同(原地还原)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void RestoreBoxes(const float *boxes, size_t count, size_t stride, BoxFormat format, float *out) const;
+
+        /**
+         * @brief    批量还原坐标点(浮点精度)
+         * @param    pts            坐标点     [count,stride]，每行前2个值为x、y
+         * @param    count          数量
+         * @param    stride         行跨度(不小于2，如关键点x,y,置信度为3)
+         * @param    out            [out]输出   [count,2]，可与pts相同(原地还原)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void RestorePoints(const float *pts, size_t count, size_t stride, float *out) const;
+
+        /**
+         * @brief    设置原图像大小(处理的是缩小解码的图像时，使Restore还原到原图像坐标)
+         * @note     在图像处理完成后调用
+         * @param    original       原图像大小
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Rescale(const cv::Size &original);
+    };
+
+    /**
+     * @brief    固定分辨率的Letterbox映射表(可同时去畸变)
+     * @note     按(源图像大小、行跨度、目标大小、标定参数)缓存；
+     *           去畸变、缩放、填充合并为一次定点双线性采样，直接写入平面RGB浮点数据
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class LetterboxMap {
+    public:
+        /**
+         * @brief    相机标定参数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            cv::Mat camera_matrix;   // 相机内参[3x3]
+            cv::Mat dist_coeffs;     // 畸变系数(k1,k2,p1,p2[,k3...])
+        } Calibration;
+
+    private:
+        typedef struct
+        {
+            int32_t  ofs;   // 左上源像素偏移(字节，-1:填充)
+            uint16_t wx;    // 右侧权重[0,256]
+            uint16_t wy;    // 下方权重[0,256]
+        } Entry;
+
+        Letterbox          let;
+        cv::Size           src_size;
+        size_t             src_step = 0;
+        std::vector<Entry> table;   // 目标像素->源像素
+        cv::Mat            map_x;   // 目标像素->源坐标(去畸变时用于还原坐标)
+        cv::Mat            map_y;
+        bool               undistort = false;
+
+    public:
+        /**
+         * @brief    获取映射表(不存在时创建并缓存)
+         * @param    src            源图像      [8UC3:BGR，至少2x2]
+         * @param    h              目标高度
+         * @param    w              目标宽度
+         * @param    calib          标定参数(为空不去畸变)
+         * @return   std::shared_ptr<const LetterboxMap>  为空表示图像不支持
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static std::shared_ptr<const LetterboxMap> Get(const cv::Mat &src, int h, int w, const Calibration *calib = nullptr);
+
+        /**
+         * @brief    创建映射表(不缓存)
+         * @param    src_size       源图像大小
+         * @param    src_step       源图像行跨度(字节)
+         * @param    h              目标高度
+         * @param    w              目标宽度
+         * @param    calib          标定参数(为空不去畸变)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        LetterboxMap(const cv::Size &src_size, size_t src_step, int h, int w, const Calibration *calib = nullptr);
+
+        /**
+         * @brief    处理图像
+         * @param    src            源图像(大小和行跨度需与映射表一致)
+         * @param    scale          归一化系数
+         * @param    dst            [out]输出   [3,h,w:RGB]
+         * @param    y_begin        目标行[y_begin,y_end)
+         * @param    y_end          目标行
+         * @return   std::string    错误信息
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        std::string MakeNCHW(const cv::Mat &src, float scale, float *dst, int y_begin = 0, int y_end = INT_MAX) const;
+
+        inline const Letterbox &GetLetterbox() const { return this->let; }
+
+        /**
+         * @brief    还原坐标(目标图像->源图像，去畸变时查表插值)
+         * @param    pt             目标图像坐标
+         * @return   cv::Point2f
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        cv::Point2f Restore(const cv::Point2f &pt) const;
+        cv::Point   Restore(const cv::Point &pt) const;
+        cv::Rect    Restore(const cv::Rect &box) const;
+    };
+
+    /**
+     * @brief    预读图片读取器
+     * @note     文件读取和解码在工作线程执行，按文件顺序返回；预读数量有上限，消费慢时工作线程等待
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class ImageReader {
+    public:
+        typedef struct
+        {
+            size_t      index;      // 文件序号
+            std::string path;       // 文件路径
+            cv::Mat     img;        // BGR图像(为空表示读取失败)
+            cv::Size    original;   // 原图像大小(缩小解码时与img大小不同)
+        } Frame;
+
+    private:
+        strings                 files;
+        cv::Size2i              size;
+        size_t                  prefetch;
+        std::mutex              mutex;
+        std::condition_variable cond;
+        std::map<size_t, Frame> ready;        // 已完成的图片
+        size_t                  posted = 0;   // 已提交的数量
+        size_t                  next   = 0;   // 下一个返回的序号
+        Tools::ThreadPool       pool;         // 最后声明，最先析构(等待任务完成)
+
+        void Fill();
+        void Load(size_t index);
+
+    public:
+        /**
+         * @brief    创建读取器(立即开始预读)
+         * @param    files          文件路径列表
+         * @param    threads        工作线程数量
+         * @param    prefetch       最大预读数量
+         * @param    size           模型输入大小(不为空时JPEG按此大小缩小解码，见ImageReadReduced)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        ImageReader(const strings &files, int threads = 2, int prefetch = 8, const cv::Size2i &size = cv::Size2i());
+
+        ImageReader(const ImageReader &)            = delete;
+        ImageReader &operator=(const ImageReader &) = delete;
+
+        /**
+         * @brief    获取下一张图片(未就绪时阻塞)
+         * @param    frame          [out]图片
+         * @return   true           成功
+         * @return   false          已读完
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool Next(Frame &frame);
+
+        inline size_t Size() const { return this->files.size(); }
     };
 
     /**
@@ -176,19 +497,163 @@ namespace Tools {
     };
 
     /**
-     * @brief    图片转张量
+     * @brief    图片转张量(RGB)
      * @param    imgs           图片列表    [8UC3:BGR]
      * @param    size           转换大小
-     * @param    lets           转换形变
+     * @param    lets           转换形变(按图片顺序追加)
      * @param    err            错误信息
-     * @return   Tensor<float>
+     * @param    scale          归一化系数(如1/255.0f，与转换一起完成)
+     * @param    executor       执行器(不为空时按图片/行分块并行处理，为空时在当前线程处理)
+     * @return   Tensor<float>  [N,3,H,W]
      * @author   CXS (chenxiangshu@outlook.com)
      * @date     2024-01-11
      */
     extern AIMethod::Tensor<float> ImageBGRToNCHW(const std::vector<cv::Mat>    &imgs,
                                                   const cv::Size2i              &size,
                                                   std::vector<Tools::Letterbox> &lets,
-                                                  std::string                   &err);
+                                                  std::string                   &err,
+                                                  float                          scale    = 1.0f,
+                                                  Tools::IExecutor              *executor = nullptr);
+
+    /**
+     * @brief    图片转张量(RGB)，写入已分配的内存
+     * @note     每块直接写入各自图片在批次中的位置；当前线程也参与处理，并等待所有块完成；
+     *           执行器繁忙(包括在执行器的任务中调用)时未开始的块由当前线程处理，不会死锁
+     * @param    imgs           图片列表    [8UC3:BGR]
+     * @param    size           转换大小
+     * @param    dst            [out]输出   [N,3,H,W]
+     * @param    lets           转换形变(按图片顺序追加)
+     * @param    scale          归一化系数
+     * @param    executor       执行器(为空时在当前线程处理)
+     * @return   std::string    错误信息
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern std::string ImageBGRToNCHW(const std::vector<cv::Mat>    &imgs,
+                                      const cv::Size2i              &size,
+                                      float                         *dst,
+                                      std::vector<Tools::Letterbox> &lets,
+                                      float                          scale    = 1.0f,
+                                      Tools::IExecutor              *executor = nullptr);
+
+    /**
+     * @brief    图片转张量(RGB，最小填充)
+     * @note     目标大小由Letterbox::AutoSize计算，用于动态输入形状的模型(Prepare时H、W为-1)，
+     *           计算量随图像实际区域变化；各批次形状不同时可配合Parameters::shape_sessions使用；
+     *           图片列表为空或包含空图片时返回错误
+     * @param    imgs           图片列表
+     * @param    size           最大转换大小
+     * @param    stride         步长
+     * @param    lets           转换形变
+     * @param    err            错误信息
+     * @param    scale          归一化系数
+     * @param    executor       执行器(为空时在当前线程处理)
+     * @return   Tensor<float>  [N,3,H,W]
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern AIMethod::Tensor<float> ImageBGRToNCHWAuto(const std::vector<cv::Mat>    &imgs,
+                                                      const cv::Size2i              &size,
+                                                      int                            stride,
+                                                      std::vector<Tools::Letterbox> &lets,
+                                                      std::string                   &err,
+                                                      float                          scale    = 1.0f,
+                                                      Tools::IExecutor              *executor = nullptr);
+
+    /**
+     * @brief    划分图块(相邻图块重叠，均匀分布并覆盖整个图像)
+     * @param    src            源图像大小
+     * @param    size           图块大小(模型输入大小)
+     * @param    overlap        重叠比例[0,0.9]
+     * @return   std::vector<cv::Rect> 图块区域(图像小于图块的方向取图像大小)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern std::vector<cv::Rect> SplitTiles(const cv::Size &src, const cv::Size2i &size, float overlap = 0.2f);
+
+    /**
+     * @brief    高分辨率图片分块转张量(所有图块组成一个批次，一次推理)
+     * @note     图块按原分辨率裁剪(引用源图像，不拷贝)，小目标不会因整图缩小而丢失；
+     *           检测结果使用TargetDetection::MergeTiles还原到整图坐标并跨图块去重
+     * @param    img            图片
+     * @param    size           图块大小(模型输入大小)
+     * @param    overlap        重叠比例
+     * @param    full_frame     是否追加整图缩小的图块(检测超出图块大小的目标)
+     * @param    tiles          [out]图块区域(与批次顺序一致)
+     * @param    lets           [out]转换形变(与批次顺序一致)
+     * @param    err            错误信息
+     * @param    scale          归一化系数
+     * @param    executor       执行器(为空时在当前线程处理)
+     * @return   Tensor<float>  [N,3,H,W]
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern AIMethod::Tensor<float> ImageTilesToNCHW(const cv::Mat                 &img,
+                                                    const cv::Size2i              &size,
+                                                    float                          overlap,
+                                                    bool                           full_frame,
+                                                    std::vector<cv::Rect>         &tiles,
+                                                    std::vector<Tools::Letterbox> &lets,
+                                                    std::string                   &err,
+                                                    float                          scale    = 1.0f,
+                                                    Tools::IExecutor              *executor = nullptr);
+
+    /**
+     * @brief    YUV图片转张量(RGB)
+     * @note     颜色转换、Letterbox、归一化、HWC转CHW一次完成，结果与cvtColor转BGR后再ImageBGRToNCHW一致
+     * @param    imgs           图片列表
+     * @param    size           转换大小
+     * @param    dst            [out]输出   [N,3,H,W]
+     * @param    lets           转换形变(按图片顺序追加)
+     * @param    scale          归一化系数
+     * @param    executor       执行器(为空时在当前线程处理)
+     * @return   std::string    错误信息
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern std::string YUVToNCHW(const std::vector<YUVImage>   &imgs,
+                                 const cv::Size2i              &size,
+                                 float                         *dst,
+                                 std::vector<Tools::Letterbox> &lets,
+                                 float                          scale    = 1.0f,
+                                 Tools::IExecutor              *executor = nullptr);
+
+    extern AIMethod::Tensor<float> YUVToNCHW(const std::vector<YUVImage>   &imgs,
+                                             const cv::Size2i              &size,
+                                             std::vector<Tools::Letterbox> &lets,
+                                             std::string                   &err,
+                                             float                          scale    = 1.0f,
+                                             Tools::IExecutor              *executor = nullptr);
+
+    /**
+     * @brief    图片转uint8张量(不做归一化和通道变换)
+     * @note     用于输入已改为uint8 NHWC BGR的模型(见prologue.py)，类型转换、归一化、BGR转RGB和NCHW转换在模型中完成；
+     *           单张图片时直接引用图像数据
+     * @param    imgs           图片列表    [8UC3:BGR]
+     * @param    size           转换大小
+     * @param    lets           转换形变
+     * @param    err            错误信息
+     * @return   Tensor<uint8_t> [N,H,W,3]
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern AIMethod::Tensor<uint8_t> ImageBGRToNHWC(const std::vector<cv::Mat>    &imgs,
+                                                    const cv::Size2i              &size,
+                                                    std::vector<Tools::Letterbox> &lets,
+                                                    std::string                   &err);
+
+    /**
+     * @brief    按模型输入大小读取图片
+     * @note     JPEG在解码时按1/2、1/4、1/8缩小(DCT域，IMREAD_REDUCED_*)，取不小于Letterbox缩放后大小的最小解码尺寸；
+     *           得到的变换信息需调用Letterbox::Rescale(original)还原到原图像坐标
+     * @param    path           文件路径
+     * @param    size           模型输入大小
+     * @param    original       [out]原图像大小
+     * @return   cv::Mat        BGR图像(为空表示读取失败)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern cv::Mat ImageReadReduced(const std::string &path, const cv::Size2i &size, cv::Size &original);
 }   // namespace Tools
 
 #endif   // __Tools_CV_hpp__
@@ -0,0 +1,104 @@
+
+#include "Tools.Perf.hpp"
+
+namespace Tools {
+    uint64_t GetNanosecond(void)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+
+    // --------------------------------------------------------------------------------
+    //                                Histogram
+    // --------------------------------------------------------------------------------
+
+    Histogram::Histogram()
+    {
+        this->Reset();
+        return;
+    }
+
+    int Histogram::Index(uint64_t value)
+    {
+        if (value < SUB_SIZE)
+            return (int)value;
+        int e = 63 - __builtin_clzll(value);   // 最高位
+        int m = (int)(value >> (e - SUB_BITS));   // [SUB_SIZE, 2*SUB_SIZE)
+        return (e - SUB_BITS + 1) * SUB_SIZE + (m - SUB_SIZE);
+    }
+
+    uint64_t Histogram::Value(int index)
+    {
+        if (index < SUB_SIZE)
+            return index;
+        int      e     = index / SUB_SIZE + SUB_BITS - 1;
+        uint64_t m     = index % SUB_SIZE + SUB_SIZE;
+        uint64_t low   = m << (e - SUB_BITS);
+        uint64_t width = 1ULL << (e - SUB_BITS);
+        return low + (width >> 1);   // 取桶中间值
+    }
+
+    void Histogram::Record(uint64_t value)
+    {
+        this->buckets[Index(value)].fetch_add(1, std::memory_order_relaxed);
+        this->count.fetch_add(1, std::memory_order_relaxed);
+        this->sum.fetch_add(value, std::memory_order_relaxed);
+        auto v = this->min.load(std::memory_order_relaxed);
+        while (value < v && !this->min.compare_exchange_weak(v, value, std::memory_order_relaxed)) {}
+        v = this->max.load(std::memory_order_relaxed);
+        while (value > v && !this->max.compare_exchange_weak(v, value, std::memory_order_relaxed)) {}
+        return;
+    }
+
+    uint64_t Histogram::Percentile(double percentile) const
+    {
+        uint64_t total = 0;
+        for (int i = 0; i < BUCKETS; i++)
+            total += this->buckets[i].load(std::memory_order_relaxed);
+        if (total == 0)
+            return 0;
+        percentile     = CM_RANGE_LIMIT(percentile, 0.0, 100.0);
+        uint64_t limit = (uint64_t)ceil(total * percentile / 100.0);
+        if (limit == 0) limit = 1;
+        uint64_t n = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            n += this->buckets[i].load(std::memory_order_relaxed);
+            if (n >= limit) {
+                // 不超出实际记录的范围
+                auto v = Value(i);
+                auto a = this->min.load(std::memory_order_relaxed);
+                auto b = this->max.load(std::memory_order_relaxed);
+                return CM_RANGE_LIMIT(v, a, b);
+            }
+        }
+        return this->max.load(std::memory_order_relaxed);
+    }
+
+    Histogram::Summary Histogram::Snapshot() const
+    {
+        Summary rs;
+        rs.count      = this->count.load(std::memory_order_relaxed);
+        rs.min        = rs.count == 0 ? 0 : this->min.load(std::memory_order_relaxed);
+        rs.max        = this->max.load(std::memory_order_relaxed);
+        rs.mean       = rs.count == 0 ? 0 : (double)this->sum.load(std::memory_order_relaxed) / rs.count;
+        rs.p50        = this->Percentile(50);
+        rs.p90        = this->Percentile(90);
+        rs.p99        = this->Percentile(99);
+        auto elapsed  = GetNanosecond() - this->start_ns.load(std::memory_order_relaxed);
+        rs.throughput = elapsed == 0 ? 0 : rs.count * 1e9 / elapsed;
+        return rs;
+    }
+
+    void Histogram::Reset()
+    {
+        for (int i = 0; i < BUCKETS; i++)
+            this->buckets[i].store(0, std::memory_order_relaxed);
+        this->count.store(0, std::memory_order_relaxed);
+        this->sum.store(0, std::memory_order_relaxed);
+        this->min.store(UINT64_MAX, std::memory_order_relaxed);
+        this->max.store(0, std::memory_order_relaxed);
+        this->start_ns.store(GetNanosecond(), std::memory_order_relaxed);
+        return;
+    }
+}   // namespace Tools
@@ -0,0 +1,108 @@
+/**
+ * @file     Tools.Perf.hpp
+ * @brief    性能统计
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#if !defined(__Tools_Perf_hpp__)
+#define __Tools_Perf_hpp__
+#include "Tools.hpp"
+
+namespace Tools {
+    /**
+     * @brief    单调时钟(纳秒)
+     * @return   uint64_t
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    extern uint64_t GetNanosecond(void);
+
+    /**
+     * @brief    无锁直方图(HDR风格对数分桶，相对误差约3%)
+     * @note     Record 可在任意线程并发调用
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class Histogram {
+    private:
+        static const int SUB_BITS = 5;                            // 每个2的幂区间细分 2^SUB_BITS 个桶
+        static const int SUB_SIZE = 1 << SUB_BITS;                // 32
+        static const int BUCKETS  = (64 - SUB_BITS + 1) * SUB_SIZE;
+
+        std::atomic<uint64_t> buckets[BUCKETS];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+        std::atomic<uint64_t> start_ns;   // 统计开始时间
+
+        static int      Index(uint64_t value);
+        static uint64_t Value(int index);
+
+    public:
+        /**
+         * @brief    统计摘要(单位与Record一致)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        typedef struct
+        {
+            uint64_t count;        // 数量
+            uint64_t min;          // 最小值
+            uint64_t max;          // 最大值
+            double   mean;         // 平均值
+            uint64_t p50;          // 50%
+            uint64_t p90;          // 90%
+            uint64_t p99;          // 99%
+            double   throughput;   // 吞吐量(每秒记录数量)
+        } Summary;
+
+        Histogram();
+
+        Histogram(const Histogram &)            = delete;
+        Histogram &operator=(const Histogram &) = delete;
+
+        /**
+         * @brief    记录
+         * @param    value          值(纳秒)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Record(uint64_t value);
+
+        /**
+         * @brief    百分位
+         * @param    percentile     百分位[0,100]
+         * @return   uint64_t
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        uint64_t Percentile(double percentile) const;
+
+        /**
+         * @brief    统计摘要
+         * @return   Summary
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        Summary Snapshot() const;
+
+        /**
+         * @brief    清空(与Record并发时，清空期间的记录可能丢失)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Reset();
+    };
+}   // namespace Tools
+
+#endif   // __Tools_Perf_hpp__
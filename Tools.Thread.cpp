@@ -0,0 +1,231 @@
+
+#include "Tools.Thread.hpp"
+#include <chrono>
+
+namespace Tools {
+    // --------------------------------------------------------------------------------
+    //                                ThreadPool
+    // --------------------------------------------------------------------------------
+
+    ThreadPool::ThreadPool(int threads)
+    {
+        if (threads < 1) threads = 1;
+        for (int i = 0; i < threads; i++)
+            this->workers.push_back(std::thread(&ThreadPool::Run, this));
+        return;
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stop = true;
+        }
+        this->cond.notify_all();
+        for (auto &thr : this->workers)
+            thr.join();
+        return;
+    }
+
+    void ThreadPool::Run()
+    {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->cond.wait(lock, [this] { return this->stop || !this->tasks.empty(); });
+                if (this->tasks.empty())
+                    return;   // 已停止且任务清空
+                task = $(this->tasks.front());
+                this->tasks.pop();
+            }
+            task();
+        }
+    }
+
+    bool ThreadPool::Post(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (this->stop)
+                return false;
+            this->tasks.push($(task));
+        }
+        this->cond.notify_one();
+        return true;
+    }
+
+    // --------------------------------------------------------------------------------
+    //                                CompletionExecutor
+    // --------------------------------------------------------------------------------
+
+    CompletionExecutor::CompletionExecutor(int threads, size_t capacity, std::function<void()> notify) :
+        tasks(capacity),
+        notify($(notify)),
+        pending(0),
+        sleeping(0),
+        stop(false)
+    {
+        for (int i = 0; i < threads; i++)
+            this->workers.push_back(std::thread(&CompletionExecutor::Run, this));
+        return;
+    }
+
+    CompletionExecutor::~CompletionExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stop.store(true);
+        }
+        this->cond.notify_all();
+        for (auto &thr : this->workers)
+            thr.join();
+        // 无线程或线程退出后剩余的任务
+        this->Poll();
+        return;
+    }
+
+    void CompletionExecutor::Run()
+    {
+        std::function<void()> task;
+        while (true) {
+            if (this->tasks.TryPop(task)) {
+                this->pending.fetch_sub(1);
+                task();
+                task = nullptr;
+                continue;
+            }
+            // 先登记等待再检查，提交方看到等待者才需要加锁唤醒
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->sleeping.fetch_add(1);
+            this->cond.wait(lock, [this] { return this->stop.load() || this->pending.load() != 0; });
+            this->sleeping.fetch_sub(1);
+            if (this->stop.load() && this->pending.load() == 0)
+                return;
+        }
+    }
+
+    bool CompletionExecutor::Post(std::function<void()> task)
+    {
+        if (this->stop.load())
+            return false;
+        // 先计数再入队，计数不小于队列中的任务数
+        this->pending.fetch_add(1);
+        if (!this->tasks.TryPush(task)) {
+            this->pending.fetch_sub(1);
+            return false;
+        }
+        if (this->sleeping.load() != 0) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->cond.notify_one();
+        }
+        if (this->notify)
+            this->notify();
+        return true;
+    }
+
+    size_t CompletionExecutor::Poll(size_t max)
+    {
+        size_t                n = 0;
+        std::function<void()> task;
+        while (n < max && this->tasks.TryPop(task)) {
+            this->pending.fetch_sub(1);
+            task();
+            task = nullptr;
+            n++;
+        }
+        return n;
+    }
+
+    // --------------------------------------------------------------------------------
+    //                                Timer
+    // --------------------------------------------------------------------------------
+
+    Timer::Timer()
+    {
+        this->thread = std::thread(&Timer::Run, this);
+        return;
+    }
+
+    Timer::~Timer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stop = true;
+        }
+        this->cond.notify_all();
+        this->thread.join();
+        return;
+    }
+
+    void Timer::Run()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (!this->stop) {
+            if (this->tasks.empty()) {
+                this->cond.wait(lock);
+                continue;
+            }
+            auto it  = this->tasks.begin();
+            auto now = GetNanosecond();
+            if (it->first.first > now) {
+                this->cond.wait_for(lock, std::chrono::nanoseconds(it->first.first - now));
+                continue;
+            }
+            auto task     = $(it->second);
+            this->running = it->first.second;
+            this->times.erase(it->first.second);
+            this->tasks.erase(it);
+            lock.unlock();
+            task();
+            task = nullptr;
+            lock.lock();
+            this->running = 0;
+            this->finished.notify_all();
+        }
+        return;
+    }
+
+    uint64_t Timer::Add(uint64_t time_ns, std::function<void()> task)
+    {
+        uint64_t id;
+        bool     first;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            id                         = this->next_id++;
+            this->tasks[{time_ns, id}] = $(task);
+            this->times[id]            = time_ns;
+            first                      = this->tasks.begin()->first.second == id;
+        }
+        // 最早的任务发生变化才需要唤醒
+        if (first)
+            this->cond.notify_one();
+        return id;
+    }
+
+    void Timer::Remove(uint64_t id)
+    {
+        std::function<void()>        task;   // 在锁外析构
+        std::unique_lock<std::mutex> lock(this->mutex);
+        auto                         it = this->times.find(id);
+        if (it == this->times.end()) {
+            // 正在执行时等待完成，调用者之后可以安全释放任务引用的对象
+            if (std::this_thread::get_id() != this->thread.get_id())
+                this->finished.wait(lock, [this, id] { return this->running != id; });
+            return;
+        }
+        auto t = this->tasks.find({it->second, id});
+        if (t != this->tasks.end()) {
+            task = $(t->second);
+            this->tasks.erase(t);
+        }
+        this->times.erase(it);
+        return;
+    }
+
+    Timer &Timer::Default()
+    {
+        static Timer timer;
+        return timer;
+    }
+}   // namespace Tools
@@ -0,0 +1,437 @@
+/**
+ * @file     Tools.Thread.hpp
+ * @brief    线程工具
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#if !defined(__Tools_Thread_hpp__)
+#define __Tools_Thread_hpp__
+#include "Tools.Perf.hpp"
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <deque>
+
+namespace Tools {
+    /**
+     * @brief    执行器接口
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class IExecutor {
+    public:
+        virtual ~IExecutor() = default;
+
+        /**
+         * @brief    提交任务
+         * @param    task           任务
+         * @return   true           成功
+         * @return   false          执行器已停止
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual bool Post(std::function<void()> task) = 0;
+    };
+
+    /**
+     * @brief    常驻线程池
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class ThreadPool : public IExecutor {
+    private:
+        std::vector<std::thread>          workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex                        mutex;
+        std::condition_variable           cond;
+        bool                              stop = false;
+
+        void Run();
+
+    public:
+        /**
+         * @brief    创建线程池
+         * @param    threads        线程数量(小于1时按1处理)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        explicit ThreadPool(int threads);
+
+        /**
+         * @brief    销毁线程池(等待已提交的任务执行完成)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual ~ThreadPool();
+
+        ThreadPool(const ThreadPool &)            = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief    线程数量
+         * @return   size_t
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        inline size_t Size() const
+        {
+            return this->workers.size();
+        }
+
+        /**
+         * @brief    提交任务
+         * @param    task           任务
+         * @return   true           成功
+         * @return   false          线程池已停止
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual bool Post(std::function<void()> task) override;
+    };
+
+    /**
+     * @brief    有界阻塞队列(满时Push阻塞，空时Pop阻塞)
+     * @tparam T
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    template<typename T>
+    class BlockingQueue {
+    private:
+        std::deque<T>           items;
+        size_t                  capacity;
+        std::mutex              mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        bool                    closed = false;
+
+    public:
+        /**
+         * @brief    创建队列
+         * @param    capacity       容量(小于1时按1处理)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        explicit BlockingQueue(size_t capacity) :
+            capacity(capacity < 1 ? 1 : capacity) {}
+
+        BlockingQueue(const BlockingQueue &)            = delete;
+        BlockingQueue &operator=(const BlockingQueue &) = delete;
+
+        /**
+         * @brief    入队(队列满时等待)
+         * @param    item           元素
+         * @return   true           成功
+         * @return   false          队列已关闭
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool Push(T item)
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->not_full.wait(lock, [this] { return this->closed || this->items.size() < this->capacity; });
+                if (this->closed)
+                    return false;
+                this->items.push_back($(item));
+            }
+            this->not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief    出队(队列空时等待)
+         * @param    item           [out]元素
+         * @return   true           成功
+         * @return   false          队列已关闭且为空
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool Pop(T &item)
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->not_empty.wait(lock, [this] { return this->closed || !this->items.empty(); });
+                if (this->items.empty())
+                    return false;
+                item = $(this->items.front());
+                this->items.pop_front();
+            }
+            this->not_full.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief    关闭(不再接受入队，剩余元素仍可出队)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->closed = true;
+            }
+            this->not_empty.notify_all();
+            this->not_full.notify_all();
+            return;
+        }
+
+        size_t Size()
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->items.size();
+        }
+    };
+
+    /**
+     * @brief    有界无锁队列(多生产者多消费者，容量为2的幂)
+     * @note     每个槽位带序号，生产者和消费者各自通过CAS领取位置，不使用互斥锁
+     * @tparam T
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    template<typename T>
+    class LockFreeQueue {
+    private:
+        typedef struct
+        {
+            std::atomic<size_t> seq;
+            T                   data;
+        } Cell;
+
+        // 生产者和消费者位置分别独占缓存行，避免伪共享
+        alignas(64) std::atomic<size_t> head;
+        alignas(64) std::atomic<size_t> tail;
+        alignas(64) std::vector<Cell> cells;
+        size_t mask;
+
+    public:
+        /**
+         * @brief    创建队列
+         * @param    capacity       容量(向上取2的幂，最小2)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        explicit LockFreeQueue(size_t capacity) :
+            head(0), tail(0)
+        {
+            size_t size = 2;
+            while (size < capacity) size <<= 1;
+            this->cells = std::vector<Cell>(size);
+            this->mask  = size - 1;
+            for (size_t i = 0; i < size; i++)
+                this->cells[i].seq.store(i, std::memory_order_relaxed);
+            return;
+        }
+
+        LockFreeQueue(const LockFreeQueue &)            = delete;
+        LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+
+        /**
+         * @brief    入队
+         * @param    item           元素(失败时不移动)
+         * @return   true           成功
+         * @return   false          队列已满
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool TryPush(T &item)
+        {
+            Cell  *cell;
+            size_t pos = this->tail.load(std::memory_order_relaxed);
+            while (true) {
+                cell     = &this->cells[pos & this->mask];
+                auto seq = cell->seq.load(std::memory_order_acquire);
+                auto dif = (intptr_t)seq - (intptr_t)pos;
+                if (dif == 0) {
+                    if (this->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;   // 槽位未被消费
+                } else {
+                    pos = this->tail.load(std::memory_order_relaxed);
+                }
+            }
+            cell->data = $(item);
+            cell->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief    出队
+         * @param    item           [out]元素
+         * @return   true           成功
+         * @return   false          队列为空
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        bool TryPop(T &item)
+        {
+            Cell  *cell;
+            size_t pos = this->head.load(std::memory_order_relaxed);
+            while (true) {
+                cell     = &this->cells[pos & this->mask];
+                auto seq = cell->seq.load(std::memory_order_acquire);
+                auto dif = (intptr_t)seq - (intptr_t)(pos + 1);
+                if (dif == 0) {
+                    if (this->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;   // 槽位未写入
+                } else {
+                    pos = this->head.load(std::memory_order_relaxed);
+                }
+            }
+            item = $(cell->data);
+            cell->data = T();
+            cell->seq.store(pos + this->mask + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    /**
+     * @brief    完成回调执行器(无锁队列，提交方不会被回调阻塞)
+     * @note     threads>0 时由内部线程执行；threads=0 时由调用者在自己的事件循环中调用 Poll 执行，
+     *           提交后调用 notify 唤醒事件循环(如写eventfd)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class CompletionExecutor : public IExecutor {
+    private:
+        LockFreeQueue<std::function<void()>> tasks;
+        std::function<void()>                notify;
+        std::vector<std::thread>             workers;
+        std::atomic<size_t>                  pending;    // 已提交未取出的任务数
+        std::atomic<int>                     sleeping;   // 等待中的线程数
+        std::atomic<bool>                    stop;
+        std::mutex                           mutex;
+        std::condition_variable              cond;
+
+        void Run();
+
+    public:
+        /**
+         * @brief    创建执行器
+         * @param    threads        线程数量(0:不创建线程，由调用者Poll)
+         * @param    capacity       队列容量
+         * @param    notify         提交后的通知(可为空，在提交线程中调用，应尽快返回)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        CompletionExecutor(int threads, size_t capacity, std::function<void()> notify);
+
+        explicit CompletionExecutor(int threads) :
+            CompletionExecutor(threads, 1024, nullptr) {}
+
+        /**
+         * @brief    销毁执行器(执行完剩余任务)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual ~CompletionExecutor();
+
+        CompletionExecutor(const CompletionExecutor &)            = delete;
+        CompletionExecutor &operator=(const CompletionExecutor &) = delete;
+
+        /**
+         * @brief    提交任务
+         * @param    task           任务
+         * @return   true           成功
+         * @return   false          队列已满或已停止(调用者应在当前线程执行)
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        virtual bool Post(std::function<void()> task) override;
+
+        /**
+         * @brief    在当前线程执行已提交的任务
+         * @param    max            最多执行的任务数
+         * @return   size_t         执行的任务数
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        size_t Poll(size_t max);
+
+        size_t Poll()
+        {
+            return this->Poll(SIZE_MAX);
+        }
+
+        /**
+         * @brief    等待执行的任务数
+         * @return   size_t
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        size_t Pending() const
+        {
+            return this->pending.load();
+        }
+    };
+
+    /**
+     * @brief    定时器(单线程按时间顺序执行任务)
+     * @author   CXS (chenxiangshu@outlook.com)
+     * @date     2026-10-18
+     */
+    class Timer {
+    private:
+        std::thread                                                   thread;
+        std::mutex                                                    mutex;
+        std::condition_variable                                       cond;
+        std::condition_variable                                       finished;   // 任务执行完成
+        std::map<std::pair<uint64_t, uint64_t>, std::function<void()>> tasks;      // (时间,编号)->任务
+        std::map<uint64_t, uint64_t>                                  times;      // 编号->时间
+        uint64_t                                                      next_id = 1;
+        uint64_t                                                      running = 0;   // 正在执行的任务编号
+        bool                                                          stop    = false;
+
+        void Run();
+
+    public:
+        Timer();
+        virtual ~Timer();
+
+        Timer(const Timer &)            = delete;
+        Timer &operator=(const Timer &) = delete;
+
+        /**
+         * @brief    添加任务(任务在定时器线程中执行，应尽快返回)
+         * @param    time_ns        执行时间(Tools::GetNanosecond时钟)
+         * @param    task           任务
+         * @return   uint64_t       编号
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        uint64_t Add(uint64_t time_ns, std::function<void()> task);
+
+        /**
+         * @brief    删除任务(返回后任务不会再执行，正在执行时等待完成，在任务中调用时不等待)
+         * @param    id             编号
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        void Remove(uint64_t id);
+
+        /**
+         * @brief    默认定时器
+         * @return   Timer&
+         * @author   CXS (chenxiangshu@outlook.com)
+         * @date     2026-10-18
+         */
+        static Timer &Default();
+    };
+}   // namespace Tools
+
+#endif   // __Tools_Thread_hpp__
@@ -1,5 +1,9 @@
 
 #include "Tools.hpp"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <set>
 
 namespace Tools {
     strings SplitString(const std::string &s, const std::string &c)
@@ -42,31 +46,65 @@ namespace Tools {
         return str;
     }
 
+    typedef std::set<std::pair<dev_t, ino_t>> DirSet;
+
     /**
-     * @brief    执行命令
-     * @param    cmd
-     * @return   string
+     * @brief    遍历目录
+     * @param    root           根目录
+     * @param    sub            子目录(相对根目录，为空表示根目录)
+     * @param    suffix         文件后缀(为空时不过滤)
+     * @param    recursive      是否递归子目录
+     * @param    visited        已遍历的目录(设备号+节点号，符号链接指向已遍历的目录时跳过，避免循环)
+     * @param    files          [out]文件列表(相对根目录)
      * @author   CXS (chenxiangshu@outlook.com)
-     * @date     2024-01-19
+     * @date     2026-10-18
      */
-    static string RunCmd(const char *cmd)
+    static void ListDir(const std::string &root, const std::string &sub, const std::string &suffix, bool recursive, DirSet &visited, strings &files)
     {
-        auto fd = popen(cmd, "r");
-        if (fd < 0) return "";
-        char        tmp[1024];
-        std::string str;
-        while (!feof(fd)) {
-            auto rs = fread(tmp, 1, sizeof(tmp) - 1, fd);
-            if (rs == 0) break;
-            tmp[rs] = '\0';
-            str += tmp;
+        std::string path = sub.empty() ? root : root + "/" + sub;
+        DIR        *dir  = opendir(path.c_str());
+        if (dir == nullptr)
+            return;
+        struct stat self;
+        if (fstat(dirfd(dir), &self) != 0 || !visited.insert(std::make_pair(self.st_dev, self.st_ino)).second) {
+            closedir(dir);
+            return;
         }
-        pclose(fd);
-        return str;
+        std::string ext = "." + suffix;
+        while (auto ent = readdir(dir)) {
+            std::string name = ent->d_name;
+            // 与 ls 一致，跳过隐藏文件和目录(如 macOS 生成的 ._x.jpg)
+            if (name[0] == '.')
+                continue;
+            std::string rel    = sub.empty() ? name : sub + "/" + name;
+            bool        is_dir = ent->d_type == DT_DIR;
+            bool        is_reg = ent->d_type == DT_REG;
+            // 部分文件系统不提供类型
+            if (ent->d_type == DT_UNKNOWN || ent->d_type == DT_LNK) {
+                struct stat st;
+                if (stat((path + "/" + name).c_str(), &st) != 0)
+                    continue;
+                is_dir = S_ISDIR(st.st_mode);
+                is_reg = S_ISREG(st.st_mode);
+            }
+            if (is_dir && recursive)
+                ListDir(root, rel, suffix, recursive, visited, files);
+            if (!is_reg)
+                continue;
+            if (!suffix.empty() && (name.size() <= ext.size() || name.compare(name.size() - ext.size(), ext.size(), ext) != 0))
+                continue;
+            files.push_back(rel);
+        }
+        closedir(dir);
+        return;
     }
 
-    strings GetFiles(const std::string &dir, const std::string &suffix)
+    strings GetFiles(const std::string &dir, const std::string &suffix, bool recursive)
     {
-        return SplitString(RunCmd(("cd \"" + dir + "\" && ls *." + suffix).c_str()), "\n");
+        strings files;
+        DirSet  visited;
+        ListDir(dir, std::string(), suffix, recursive, visited, files);
+        std::sort(files.begin(), files.end());
+        return files;
     }
 }   // namespace Tools
\ No newline at end of file
@@ -164,13 +164,17 @@ namespace Tools {
     std::string JoinString(const strings &s, const std::string &c);
 
     /**
-     * @brief    获取文件列表
-     * @param    dir
-     * @return   strings
+     * @brief    获取文件列表(按名称排序)
+     * @note     跟随符号链接；递归时同一目录只遍历一次，指向上级目录的链接不会造成死循环；
+     *           跳过以'.'开头的隐藏文件和目录
+     * @param    dir            目录
+     * @param    suffix         文件后缀(不含'.'，为空时不过滤)
+     * @param    recursive      是否递归子目录
+     * @return   strings        文件列表(相对dir的路径)
      * @author   CXS (chenxiangshu@outlook.com)
      * @date     2024-01-19
      */
-    strings GetFiles(const std::string &dir, const std::string &suffix);
+    strings GetFiles(const std::string &dir, const std::string &suffix, bool recursive = false);
 
 }   // namespace Tools
 #endif   // __TOOLS_HPP_
@@ -11,10 +11,14 @@
 #include "TargetSegmention.hpp"
 #include "Ratiocinate.hpp"
 #include "PoseEstimation.hpp"
+#include "Pipeline.hpp"
 #include "Algorithm.hpp"
 
 #include <time.h>
 #include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
 
 #include "Tensor.hpp"
 #include "Define.h"
@@ -46,7 +50,7 @@ static void ExecCallback(IRatiocinate                            *infer,
     else {
 #if IS_TARGETDETECTION
         TargetDetection det;
-        auto            ret = Tensor<float>::MakeConst(output_datas[0].shape, output_datas[0].data);
+        auto            ret = output_datas[0];
         auto            rs  = det.Yolo(ret, lets);
         for (size_t i = 0; i < imgs.size(); i++) {
             auto &img  = imgs[i];
@@ -70,8 +74,8 @@ static void ExecCallback(IRatiocinate                            *infer,
             int              color_idx = 0;
             TargetDetection  det;
             TargetSegmention seg;
-            auto             pred  = Tensor<float>::MakeConst(output_datas[0].shape, output_datas[0].data);
-            auto             proto = Tensor<float>::MakeConst(output_datas[1].shape, output_datas[1].data);
+            auto             pred  = output_datas[0];
+            auto             proto = output_datas[1];
             auto             rs    = seg.Yolo(det, pred, proto, lets);
             if (rs.size() == imgs.size()) {
                 for (size_t i = 0; i < rs.size(); i++) {
@@ -116,8 +120,7 @@ void _TargetSegmention(IRatiocinate *infer)
 #else
     cv::Size2i size(640, 640);
 #endif
-    auto inputs = Tools::ImageBGRToNCHW(imgs, size, lets, err);
-    inputs      = op.Mul($(inputs), 1 / 255.0f);
+    auto inputs = Tools::ImageBGRToNCHW(imgs, size, lets, err, 1 / 255.0f);
 
     err = infer->ExecAsync({"images"}, {"output0", "output1"}, {inputs});
     inputs.Clear();
@@ -136,7 +139,7 @@ static void ExecCallback_PoseEstimation(IRatiocinate
         printf("Err: %s", err.c_str());
         return;
     }
-    auto           detections = Tensor<float>::MakeConst(output_datas[0].shape, output_datas[0].data);
+    auto           detections = output_datas[0];
     PoseEstimation pose;
     auto           ret = pose.Yolo(detections, lets[0]);
     pose.DrawBox(imgs[0], ret);
@@ -163,8 +166,7 @@ void _PoseEstimation(IRatiocinate *infer)
 
     imgs.push_back(cv::imread("./img/zidane.jpg"));
     cv::Size2i size(640, 640);
-    auto       inputs = Tools::ImageBGRToNCHW(imgs, size, lets, err);
-    inputs            = op.Mul($(inputs), 1 / 255.0f);
+    auto       inputs = Tools::ImageBGRToNCHW(imgs, size, lets, err, 1 / 255.0f);
 
     err = infer->ExecAsync({"images"}, {"detections"}, {inputs});
     return;
@@ -172,12 +174,14 @@ void _PoseEstimation(IRatiocinate *infer)
 
 class PoseEstimation_test {
 private:
-    strings          files;
-    int              idx   = -1;
-    IRatiocinate    *infer = nullptr;
-    cv::Mat          img;
-    Tools::Letterbox let;
-    const string     dir = "/home/work/yolo5-onnx/img/test1";
+    strings                   files;
+    int                       idx   = -1;
+    IRatiocinate             *infer = nullptr;
+    IRatiocinate::Binding     binding;
+    cv::Mat                   img;
+    Tools::Letterbox          let;
+    const string              dir = "/home/work/yolo5-onnx/img/test1";
+    Tools::CompletionExecutor completion;   // 解码、画框、保存不占用推理线程
 
     static void ExecCallback(IRatiocinate                            *infer,
                              const std::vector<std::string>          &input_names,
@@ -192,7 +196,7 @@ private:
             printf("Err: %s", err.c_str());
             exit(1);
         }
-        auto           detections = Tensor<float>::MakeConst(output_datas[0].shape, output_datas[0].data);
+        auto           detections = output_datas[0];
         PoseEstimation pose;
         auto           ret = pose.Yolo(detections, ps->let);
         pose.DrawBox(ps->img, ret);
@@ -203,7 +207,8 @@ private:
 
 public:
     PoseEstimation_test(IRatiocinate *infer) :
-        infer(infer)
+        infer(infer),
+        completion(1)
     {
         files = Tools::GetFiles(this->dir, "jpg");
 
@@ -211,12 +216,16 @@ public:
         IRatiocinate::Parameters parameters;
         parameters.model = "./onnx/yolov5s6_pose_640_ti_lite_54p9_82p2.onnx";
         // parameters.model = "./best.onnx";
+        parameters.executor = &this->completion;
 #if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
         parameters.threads = 2;
 #endif
         err                     = infer->LoadModel(parameters);
         infer->callback         = this->ExecCallback;
         infer->callback_context = this;
+        // 名称和形状只校验一次，后续执行只传输入张量
+        if (err.empty())
+            err = infer->Prepare({"images"}, {"detections"}, {{1, 3, 640, 640}}, this->binding);
 
         if (!err.empty()) {
             printf("ERR: %s\n", err.c_str());
@@ -241,16 +250,220 @@ public:
         std::vector<Tools::Letterbox> lets;
         cv::Size2i                    size(640, 640);
 
-        auto inputs = Tools::ImageBGRToNCHW({img}, size, lets, err);
-        inputs      = op.Mul($(inputs), 1 / 255.0f);
+        auto inputs = Tools::ImageBGRToNCHW({img}, size, lets, err, 1 / 255.0f);
         this->let   = lets[0];
-        err         = infer->ExecAsync({"images"}, {"detections"}, {inputs});
+        err         = infer->ExecAsync(this->binding, {inputs});
         if (err != "")
             RUN_ERR(err);
         return;
     }
 };
 
+/**
+ * @brief    创建输出目录
+ * @return   std::string    输出目录(以/结尾)，失败时为空
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @date     2026-10-18
+ */
+static std::string OutputDir()
+{
+    const char *dir = "./output/";
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        printf("ERR: mkdir %s: %s\n", dir, strerror(errno));
+        return std::string();
+    }
+    return dir;
+}
+
+void Pipeline_test(IRatiocinate *infer)
+{
+    typedef struct
+    {
+        std::string      name;
+        cv::Mat          img;
+        Tools::Letterbox let;
+    } Frame;
+
+    std::string                 err;
+    IRatiocinate::Parameters    parameters;
+    IRatiocinate::Binding       binding;
+    Pipeline<Frame>::Parameters pipe_params;
+    const std::string           out = OutputDir();
+    if (out.empty())
+        return;
+    parameters.model = "./onnx/yolov5s6_pose_640_ti_lite_54p9_82p2.onnx";
+#if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
+    parameters.threads = 2;
+#endif
+    // 两个推理任务同时执行
+    pipe_params.inflight               = 2;
+    parameters.scheduling.max_inflight = pipe_params.inflight;
+    err                                = infer->LoadModel(parameters);
+    if (err.empty())
+        err = infer->Prepare({"images"}, {"detections"}, {{1, 3, 640, 640}}, binding);
+    // 推理中的任务各占一个槽位，预处理再写入一个
+    std::shared_ptr<IRatiocinate::InputRing> ring;
+    if (err.empty())
+        err = infer->CreateInputRing(binding, 0, pipe_params.inflight + 1, ring);
+    if (!err.empty()) {
+        printf("ERR: %s\n", err.c_str());
+        return;
+    }
+    // 读图和预处理 -> 推理 -> 解码和画框 三个阶段重叠执行
+    Pipeline<Frame> pipeline(
+        infer,
+        binding,
+        [ring](Frame &frame, std::vector<IRatiocinate::Input> &inputs) {
+            if (frame.img.empty())
+                return std::string("Failed to read image");
+            std::vector<Tools::Letterbox> lets;
+            auto                          slot = ring->Acquire<float>();
+            auto                          err  = Tools::ImageBGRToNCHW({frame.img}, cv::Size2i(640, 640), slot.Value(), lets, 1 / 255.0f);
+            if (!err.empty())
+                return err;
+            frame.let = lets[0];
+            inputs    = {slot};
+            return std::string();
+        },
+        [out](Frame &frame, const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            if (!err.empty()) {
+                printf("%s: %s\n", frame.name.c_str(), err.c_str());
+                return;
+            }
+            PoseEstimation pose;
+            auto           ret = pose.Yolo(outputs[0], frame.let);
+            pose.DrawBox(frame.img, ret);
+            auto pos  = frame.name.find_last_of('/');
+            auto path = out + frame.name.substr(pos + 1);
+            if (!cv::imwrite(path, frame.img))
+                printf("ERR: Failed to write %s\n", path.c_str());
+        },
+        pipe_params);
+    // 读取和解码在读取器线程中预读
+    const std::string dir = "./img";
+    strings           files;
+    for (auto &file : Tools::GetFiles(dir, "jpg"))
+        files.push_back(dir + "/" + file);
+    Tools::ImageReader        reader(files, 2, 8);
+    Tools::ImageReader::Frame item;
+    while (reader.Next(item)) {
+        Frame frame;
+        frame.name = $(item.path);
+        frame.img  = $(item.img);
+        pipeline.Push($(frame));
+    }
+    pipeline.Wait();
+    auto st = pipeline.GetStatistics();
+    printf("frames: %llu, fps: %.2f, pre: %.2fms, infer: %.2fms, post: %.2fms\n",
+           (unsigned long long)st.total.count,
+           st.total.throughput,
+           st.pre.mean / 1e6,
+           st.infer.mean / 1e6,
+           st.post.mean / 1e6);
+    return;
+}
+
+void Tiles_test(IRatiocinate *infer)
+{
+    typedef struct
+    {
+        std::string                   name;
+        cv::Mat                       img;
+        std::vector<cv::Rect>         tiles;
+        std::vector<Tools::Letterbox> lets;
+    } Frame;
+
+    std::string              err;
+    IRatiocinate::Parameters parameters;
+    IRatiocinate::Binding    binding;
+    const std::string        out = OutputDir();
+    if (out.empty())
+        return;
+    parameters.model = "./onnx/yolov5s.onnx";
+#if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
+    parameters.threads = 2;
+#endif
+    err = infer->LoadModel(parameters);
+    // 图块数量随图像大小变化
+    if (err.empty())
+        err = infer->Prepare({"images"}, {"output0"}, {{-1, 3, 640, 640}}, binding);
+    if (!err.empty()) {
+        printf("ERR: %s\n", err.c_str());
+        return;
+    }
+    // 整图的所有图块一次推理，再加一个整图缩小的图块检测大目标
+    Tools::ThreadPool pool(4);
+    Pipeline<Frame>   pipeline(
+        infer,
+        binding,
+        [&pool](Frame &frame, std::vector<IRatiocinate::Input> &inputs) {
+            std::string err;
+            auto        data = Tools::ImageTilesToNCHW(frame.img, cv::Size2i(640, 640), 0.2f, true, frame.tiles, frame.lets, err, 1 / 255.0f, &pool);
+            if (!err.empty())
+                return err;
+            inputs = {data};
+            return std::string();
+        },
+        [out](Frame &frame, const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            if (!err.empty()) {
+                printf("%s: %s\n", frame.name.c_str(), err.c_str());
+                return;
+            }
+            TargetDetection det;
+            auto            ret = det.MergeTiles(det.Yolo(outputs[0], frame.lets), frame.tiles);
+            det.DrawBox(frame.img, ret);
+            auto pos  = frame.name.find_last_of('/');
+            auto path = out + "tiles-" + frame.name.substr(pos + 1);
+            if (!cv::imwrite(path, frame.img))
+                printf("ERR: Failed to write %s\n", path.c_str());
+        });
+    // 读取和解码在读取器线程中预读
+    const std::string dir = "./img";
+    strings           files;
+    for (auto &file : Tools::GetFiles(dir, "jpg"))
+        files.push_back(dir + "/" + file);
+    Tools::ImageReader        reader(files, 2, 8);
+    Tools::ImageReader::Frame item;
+    while (reader.Next(item)) {
+        Frame frame;
+        frame.name = $(item.path);
+        frame.img  = $(item.img);
+        pipeline.Push($(frame));
+    }
+    pipeline.Wait();
+    return;
+}
+
+#if CFG_INFER_ENGINE == INFER_ENGINE_ONNXRUNTIME
+void Benchmark_test()
+{
+    std::string              err;
+    IRatiocinate::Parameters parameters;
+    parameters.model   = "./onnx/yolov5s6_pose_640_ti_lite_54p9_82p2.onnx";
+    parameters.threads = 2;
+
+    std::vector<Tools::Letterbox> lets;
+    cv::Size2i                    size(640, 640);
+    cv::Size                      original;
+    auto                          img    = Tools::ImageReadReduced("./img/bus.jpg", size, original);
+    auto                          inputs = Tools::ImageBGRToNCHW({img}, size, lets, err, 1 / 255.0f);
+    if (!err.empty()) {
+        printf("ERR: %s\n", err.c_str());
+        return;
+    }
+    lets[0].Rescale(original);   // 检测结果还原到原图像坐标
+
+    std::vector<BenchmarkResult> results;
+    err = Ratiocinate_Benchmark(parameters, {"images"}, {"detections"}, {inputs}, 50, results);
+    if (!err.empty()) {
+        printf("ERR: %s\n", err.c_str());
+        return;
+    }
+    printf("%s", Ratiocinate_BenchmarkReport(results).c_str());
+    return;
+}
+#endif
+
 void FaceRecognize_test()
 {
     Tools::FaceRecognize face("/home/work/haar-cascade-files/haarcascade_frontalface_alt.xml",
@@ -269,7 +482,6 @@ void FaceRecognize_test()
     return;
 }
 
-
 int main(int argc, char **argv)
 {
 #if 1
@@ -0,0 +1,80 @@
+# 安装onnx：pip install onnx numpy
+# 在模型输入前插入预处理(Cast/Transpose/BGR转RGB/Div)，C++侧可直接输入uint8图像数据
+#   python prologue.py in.onnx out.onnx                  uint8 NCHW RGB 输入
+#   python prologue.py in.onnx out.onnx --nhwc --bgr     uint8 NHWC BGR 输入(cv::Mat数据，配合Tools::ImageBGRToNHWC)
+import argparse
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, TensorProto
+
+
+def add_prologue(model, name, nhwc, bgr, scale):
+    graph = model.graph
+    inputs = [i for i in graph.input if i.name == name]
+    if len(inputs) == 0:
+        raise ValueError("Unknown input: " + name)
+    src = inputs[0]
+    elem_type = src.type.tensor_type.elem_type   # 原输入类型(float/float16)
+    dims = list(src.type.tensor_type.shape.dim)
+    if len(dims) != 4:
+        raise ValueError("The input must be 4D (NCHW): " + name)
+
+    # 原输入改名，由预处理输出
+    inner = name + "_prologue"
+    for node in graph.node:
+        for i, v in enumerate(node.input):
+            if v == name:
+                node.input[i] = inner
+
+    nodes = []
+    cur = name
+    nodes.append(helper.make_node("Cast", [cur], [name + "_cast"], to=elem_type))
+    cur = name + "_cast"
+    if nhwc:
+        nodes.append(helper.make_node("Transpose", [cur], [name + "_nchw"], perm=[0, 3, 1, 2]))
+        cur = name + "_nchw"
+    if bgr:
+        # 通道顺序 BGR -> RGB
+        graph.initializer.append(numpy_helper.from_array(np.array([2, 1, 0], dtype=np.int64), name + "_bgr2rgb"))
+        nodes.append(helper.make_node("Gather", [cur, name + "_bgr2rgb"], [name + "_rgb"], axis=1))
+        cur = name + "_rgb"
+    np_type = np.float16 if elem_type == TensorProto.FLOAT16 else np.float32
+    graph.initializer.append(numpy_helper.from_array(np.array(scale, dtype=np_type), name + "_scale"))
+    nodes.append(helper.make_node("Div", [cur, name + "_scale"], [inner]))
+
+    # 新输入: uint8，名称不变(C++侧绑定不用修改)
+    shape = dims if not nhwc else [dims[0], dims[2], dims[3], dims[1]]
+    new_input = helper.make_tensor_value_info(name, TensorProto.UINT8, None)
+    for d in shape:
+        nd = new_input.type.tensor_type.shape.dim.add()
+        nd.CopyFrom(d)
+    new_inputs = [new_input if i.name == name else i for i in graph.input]
+    del graph.input[:]
+    graph.input.extend(new_inputs)
+
+    # 预处理节点放在最前面(保持拓扑顺序)
+    old_nodes = list(graph.node)
+    del graph.node[:]
+    graph.node.extend(nodes + old_nodes)
+
+
+def apply(infile, outfile, name, nhwc, bgr, scale):
+    model = onnx.load(infile)
+    if name is None:
+        inits = set(i.name for i in model.graph.initializer)
+        name = [i.name for i in model.graph.input if i.name not in inits][0]
+    add_prologue(model, name, nhwc, bgr, scale)
+    onnx.checker.check_model(model)
+    onnx.save(model, outfile)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("infile")
+    parser.add_argument("outfile")
+    parser.add_argument("--input", default=None, help="输入名称(默认第一个输入)")
+    parser.add_argument("--nhwc", action="store_true", help="输入为NHWC(cv::Mat内存布局)")
+    parser.add_argument("--bgr", action="store_true", help="输入为BGR，模型内转换为RGB")
+    parser.add_argument("--scale", type=float, default=255.0, help="除数(默认255)")
+    args = parser.parse_args()
+    apply(args.infile, args.outfile, args.input, args.nhwc, args.bgr, args.scale)
@@ -0,0 +1,69 @@
+/**
+ * @file     Test.hpp
+ * @brief    单元测试断言
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#if !defined(__Test_hpp__)
+#define __Test_hpp__
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Test {
+    /**
+     * @brief    失败数量
+     * @return   int&
+     */
+    inline int &Failures()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    /**
+     * @brief    输出结果
+     * @param    name       测试名称
+     * @return   int        进程返回值(有失败返回 1)
+     */
+    inline int Report(const char *name)
+    {
+        printf("%s: %s (%d failures)\n", name, Failures() == 0 ? "PASS" : "FAIL", Failures());
+        return Failures() == 0 ? 0 : 1;
+    }
+}   // namespace Test
+
+/**
+ * @brief    检查条件，失败时记录并输出位置
+ */
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            Test::Failures()++;                                            \
+        }                                                                  \
+    } while (0)
+
+/**
+ * @brief    检查相等
+ */
+#define CHECK_EQ(a, b)                                                                           \
+    do {                                                                                         \
+        auto _a = (a);                                                                           \
+        auto _b = (b);                                                                           \
+        if ((long long)_a != (long long)_b) {                                                    \
+            printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, \
+                   (long long)_a, (long long)_b);                                                \
+            Test::Failures()++;                                                                  \
+        }                                                                                        \
+    } while (0)
+
+#endif   // __Test_hpp__
@@ -0,0 +1,641 @@
+/**
+ * @file     test_cv.cpp
+ * @brief    Tools.CV 测试
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "Tools.CV.hpp"
+#include <future>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief    区域是否全部为填充色
+ */
+static bool IsFill(const cv::Mat &img, const cv::Rect &roi)
+{
+    if (roi.area() == 0)
+        return true;
+    cv::Mat diff;
+    cv::absdiff(img(roi), cv::Scalar(114, 114, 114), diff);
+    return cv::countNonZero(diff.reshape(1)) == 0;
+}
+
+/**
+ * @brief    平滑测试图像(插值精度差异只引起很小的误差)
+ */
+static cv::Mat SmoothImage(int h, int w)
+{
+    cv::Mat img(h, w, CV_8UC3);
+    for (int y = 0; y < h; y++) {
+        auto p = img.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < w; x++) {
+            p[x][0] = cv::saturate_cast<uint8_t>(127.5 + 127 * sin(x / 17.0 + y / 23.0));
+            p[x][1] = cv::saturate_cast<uint8_t>(127.5 + 127 * cos(x / 29.0 - y / 13.0));
+            int t   = (x * 3 + y * 2) % 512;
+            p[x][2] = (uint8_t)(t < 256 ? t : 511 - t);
+        }
+    }
+    return img;
+}
+
+/**
+ * @brief    平面RGB与BGR参考图像比较
+ * @param    planes         [3,h,w:RGB]
+ * @param    ref            参考图像(8UC3:BGR)
+ * @param    mask           比较的像素(为空全部比较)
+ * @return   float          最大误差
+ */
+static float MaxDiff(const std::vector<float> &planes, const cv::Mat &ref, const cv::Mat &mask = cv::Mat())
+{
+    size_t plane = (size_t)ref.rows * ref.cols;
+    float  diff  = 0;
+    for (int y = 0; y < ref.rows; y++) {
+        for (int x = 0; x < ref.cols; x++) {
+            if (!mask.empty() && mask.at<uint8_t>(y, x) == 0)
+                continue;
+            auto   bgr = ref.at<cv::Vec3b>(y, x);
+            size_t i   = (size_t)y * ref.cols + x;
+            for (int c = 0; c < 3; c++)
+                diff = std::max(diff, fabsf(planes[plane * c + i] - bgr[2 - c]));
+        }
+    }
+    return diff;
+}
+
+// --------------------------------------------------------------------------------
+//                                Letterbox::Make
+// --------------------------------------------------------------------------------
+
+static void LetterboxMake_test()
+{
+    struct {
+        int              src_h, src_w, h, w;
+    } cases[] = {
+        {480, 640, 640, 640},   // 上下填充 160，偶数
+        {479, 640, 640, 640},   // 上下填充为奇数
+        {640, 479, 640, 640},   // 左右填充为奇数
+        {100, 300, 101, 301},   // 两个方向都有奇数余量
+        {640, 640, 640, 640},   // 无填充
+    };
+    for (auto &c : cases) {
+        cv::Mat          src(c.src_h, c.src_w, CV_8UC3, cv::Scalar(10, 20, 30));
+        Tools::Letterbox let;
+        cv::Mat          dst    = Tools::Letterbox::Make(src, c.h, c.w, let);
+        float            r      = std::min(float(c.h) / c.src_h, float(c.w) / c.src_w);
+        cv::Size         inside(round(c.src_w * r), round(c.src_h * r));
+        int              top    = (c.h - inside.height) / 2;
+        int              left   = (c.w - inside.width) / 2;
+        int              bottom = c.h - inside.height - top;
+        int              right  = c.w - inside.width - left;
+        CHECK_EQ(dst.rows, c.h);
+        CHECK_EQ(dst.cols, c.w);
+        CHECK_EQ(dst.type(), CV_8UC3);
+        CHECK(bottom >= top && bottom - top <= 1);
+        CHECK(right >= left && right - left <= 1);
+        // 填充区域
+        CHECK(IsFill(dst, cv::Rect(0, 0, c.w, top)));
+        CHECK(IsFill(dst, cv::Rect(0, c.h - bottom, c.w, bottom)));
+        CHECK(IsFill(dst, cv::Rect(0, 0, left, c.h)));
+        CHECK(IsFill(dst, cv::Rect(c.w - right, 0, right, c.h)));
+        // 图像区域紧贴填充
+        cv::Mat          body = dst(cv::Rect(left, top, inside.width, inside.height));
+        CHECK(cv::countNonZero(body.reshape(1) == 114) == 0);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                LetterboxMap
+// --------------------------------------------------------------------------------
+
+static void LetterboxMap_test()
+{
+    // 无畸变: 与 Letterbox::Make(cv::resize + 填充)一致
+    {
+        cv::Size sizes[] = {{640, 480}, {479, 640}, {300, 100}, {200, 200}};
+        for (auto &size : sizes) {
+            cv::Mat src = SmoothImage(size.height, size.width);
+            auto    map = Tools::LetterboxMap::Get(src, 320, 320);
+            CHECK(map != nullptr);
+            if (map == nullptr)
+                continue;
+            std::vector<float> dst(3 * 320 * 320);
+            CHECK(map->MakeNCHW(src, 1.0f, dst.data()).empty());
+            cv::Mat ref = Tools::Letterbox::Make(src, 320, 320);
+            CHECK(MaxDiff(dst, ref) <= 1.0f);
+            // 分段处理与整体一致
+            std::vector<float> part(dst.size(), -1.0f);
+            CHECK(map->MakeNCHW(src, 1.0f, part.data(), 0, 100).empty());
+            CHECK(map->MakeNCHW(src, 1.0f, part.data(), 100, 320).empty());
+            CHECK(part == dst);
+        }
+    }
+    // 去畸变: 与 cv::remap(initUndistortRectifyMap) 一致
+    {
+        cv::Mat                          src = SmoothImage(480, 640);
+        Tools::LetterboxMap::Calibration calib;
+        calib.camera_matrix = (cv::Mat_<double>(3, 3) << 500, 0, 320, 0, 500, 240, 0, 0, 1);
+        calib.dist_coeffs   = (cv::Mat_<double>(1, 4) << -0.2, 0.05, 0, 0);
+        auto map            = Tools::LetterboxMap::Get(src, 320, 320, &calib);
+        CHECK(map != nullptr);
+        if (map != nullptr) {
+            std::vector<float> dst(3 * 320 * 320);
+            CHECK(map->MakeNCHW(src, 1.0f, dst.data()).empty());
+            // 参考映射: 去畸变后按Letterbox缩放平移
+            double r    = std::min(320.0 / 480, 320.0 / 640);
+            int    in_w = (int)round(640 * r);
+            int    in_h = (int)round(480 * r);
+            int    left = (320 - in_w) / 2;
+            int    top  = (320 - in_h) / 2;
+            double rx   = (double)in_w / 640;
+            double ry   = (double)in_h / 480;
+            cv::Mat new_K          = (cv::Mat_<double>(3, 3) << 500 * rx, 0, 0, 0, 500 * ry, 0, 0, 0, 1);
+            new_K.at<double>(0, 2) = (320 + 0.5) * rx - 0.5 + left;
+            new_K.at<double>(1, 2) = (240 + 0.5) * ry - 0.5 + top;
+            cv::Mat mx, my, ref;
+            cv::initUndistortRectifyMap(calib.camera_matrix, calib.dist_coeffs, cv::Mat(), new_K, cv::Size(320, 320), CV_32FC1, mx, my);
+            cv::remap(src, ref, mx, my, cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+            // 图像区域内、映射在源图像内的像素与remap比较；映射到源图像外的像素为填充
+            cv::Mat inside = cv::Mat::zeros(320, 320, CV_8U);
+            int     fills  = 0;
+            int     wrong  = 0;
+            for (int y = top; y < top + in_h; y++) {
+                for (int x = left; x < left + in_w; x++) {
+                    float sx = mx.at<float>(y, x);
+                    float sy = my.at<float>(y, x);
+                    if (sx >= 0 && sy >= 0 && sx <= 639 && sy <= 479) {
+                        inside.at<uint8_t>(y, x) = 1;
+                    } else if (sx < -1 || sy < -1 || sx > 640 || sy > 480) {
+                        fills++;
+                        if (dst[(size_t)y * 320 + x] != 114.0f)
+                            wrong++;
+                    }
+                }
+            }
+            CHECK(cv::countNonZero(inside) > in_w * in_h / 2);
+            CHECK(fills > 0);
+            CHECK_EQ(wrong, 0);
+            CHECK(MaxDiff(dst, ref, inside) <= 1.0f);
+        }
+    }
+    // 缓存与参数检查
+    {
+        cv::Mat src = SmoothImage(120, 160);
+        auto    a   = Tools::LetterboxMap::Get(src, 64, 64);
+        auto    b   = Tools::LetterboxMap::Get(src.clone(), 64, 64);
+        CHECK(a != nullptr && a == b);
+        CHECK(Tools::LetterboxMap::Get(src, 64, 32) != a);
+        CHECK(Tools::LetterboxMap::Get(cv::Mat(1, 1, CV_8UC3), 64, 64) == nullptr);
+        CHECK(Tools::LetterboxMap::Get(cv::Mat(16, 16, CV_8UC1), 64, 64) == nullptr);
+        std::vector<float> dst(3 * 64 * 64);
+        CHECK(!a->MakeNCHW(src(cv::Rect(0, 0, 80, 120)), 1.0f, dst.data()).empty());   // 大小不一致
+        cv::Mat wide = SmoothImage(120, 200);
+        CHECK(!a->MakeNCHW(wide(cv::Rect(0, 0, 160, 120)), 1.0f, dst.data()).empty());   // 行跨度不一致
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                YUVImage
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief    逐行转换并与参考BGR图像逐字节比较
+ * @return   int            不一致的行数
+ */
+static int CompareRows(const Tools::YUVImage &img, const cv::Mat &ref)
+{
+    int                  wrong = 0;
+    std::vector<uint8_t> row((size_t)img.width * 3);
+    for (int y = 0; y < img.height; y++) {
+        img.ConvertRow(y, row.data());
+        if (memcmp(row.data(), ref.ptr<uint8_t>(y), row.size()) != 0)
+            wrong++;
+    }
+    return wrong;
+}
+
+/**
+ * @brief    平面数据拷贝到行跨度更大的独立缓存(填充字节为0xAA)
+ * @param    img            连续的YUV图像
+ * @param    pad            各平面行尾填充字节数
+ * @param    planes         [out]平面缓存
+ * @return   Tools::YUVImage    引用新缓存的图像
+ */
+static Tools::YUVImage PadPlanes(const Tools::YUVImage &img, const int pad[3], std::vector<cv::Mat> &planes)
+{
+    Tools::YUVImage rs = img;
+    int             n  = img.format == Tools::YUVImage::FORMAT_YUYV ? 1 : (img.format == Tools::YUVImage::FORMAT_I420 ? 3 : 2);
+    for (int i = 0; i < n; i++) {
+        int rows  = i == 0 ? img.height : img.height / 2;
+        int bytes = img.width;
+        if (img.format == Tools::YUVImage::FORMAT_YUYV)
+            bytes = img.width * 2;
+        else if (img.format == Tools::YUVImage::FORMAT_I420 && i != 0)
+            bytes = img.width / 2;
+        cv::Mat plane(rows, bytes + pad[i], CV_8UC1, cv::Scalar(0xAA));
+        for (int y = 0; y < rows; y++)
+            memcpy(plane.ptr<uint8_t>(y), img.data[i] + (size_t)y * img.step[i], bytes);
+        rs.data[i] = plane.data;
+        rs.step[i] = plane.step[0];
+        planes.push_back(plane);
+    }
+    return rs;
+}
+
+static void YUV_test()
+{
+    cv::Size sizes[] = {{64, 32}, {38, 10}, {2, 2}};
+    for (auto &size : sizes) {
+        int w = size.width;
+        int h = size.height;
+        // 随机平面数据(包含饱和截断的组合)
+        cv::Mat py(h, w, CV_8UC1), pu(h / 2, w / 2, CV_8UC1), pv(h / 2, w / 2, CV_8UC1);
+        cv::randu(py, 0, 256);
+        cv::randu(pu, 0, 256);
+        cv::randu(pv, 0, 256);
+        // OpenCV布局: NV12/NV21/I420 为 8UC1[h*3/2,w]，YUYV 为 8UC2[h,w]
+        cv::Mat nv12(h * 3 / 2, w, CV_8UC1), nv21(h * 3 / 2, w, CV_8UC1), i420(h * 3 / 2, w, CV_8UC1), yuyv(h, w, CV_8UC2);
+        py.copyTo(nv12.rowRange(0, h));
+        py.copyTo(nv21.rowRange(0, h));
+        py.copyTo(i420.rowRange(0, h));
+        memcpy(i420.data + w * h, pu.data, w * h / 4);
+        memcpy(i420.data + w * h + w * h / 4, pv.data, w * h / 4);
+        for (int y = 0; y < h / 2; y++) {
+            for (int x = 0; x < w / 2; x++) {
+                nv12.at<uint8_t>(h + y, x * 2)     = pu.at<uint8_t>(y, x);
+                nv12.at<uint8_t>(h + y, x * 2 + 1) = pv.at<uint8_t>(y, x);
+                nv21.at<uint8_t>(h + y, x * 2)     = pv.at<uint8_t>(y, x);
+                nv21.at<uint8_t>(h + y, x * 2 + 1) = pu.at<uint8_t>(y, x);
+            }
+        }
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x += 2) {
+                uint8_t *p = yuyv.ptr<uint8_t>(y) + x * 2;
+                p[0]       = py.at<uint8_t>(y, x);
+                p[1]       = pu.at<uint8_t>(y / 2, x / 2);
+                p[2]       = py.at<uint8_t>(y, x + 1);
+                p[3]       = pv.at<uint8_t>(y / 2, x / 2);
+            }
+        }
+        struct
+        {
+            cv::Mat                 mat;
+            Tools::YUVImage::Format format;
+            int                     code;
+        } cases[] = {
+            {nv12, Tools::YUVImage::FORMAT_NV12, cv::COLOR_YUV2BGR_NV12},
+            {nv21, Tools::YUVImage::FORMAT_NV21, cv::COLOR_YUV2BGR_NV21},
+            {i420, Tools::YUVImage::FORMAT_I420, cv::COLOR_YUV2BGR_I420},
+            {yuyv, Tools::YUVImage::FORMAT_YUYV, cv::COLOR_YUV2BGR_YUYV},
+        };
+        for (auto &it : cases) {
+            cv::Mat ref;
+            cv::cvtColor(it.mat, ref, it.code);
+            CHECK_EQ(ref.rows, h);
+            CHECK_EQ(ref.cols, w);
+            // 连续数据
+            auto img = Tools::YUVImage::FromMat(it.mat, it.format);
+            CHECK(img.Check().empty());
+            CHECK_EQ(CompareRows(img, ref), 0);
+            // 各平面独立缓存、行跨度大于宽度且互不相同(I420色度平面不连续)
+            const int            pad[3] = {16, 8, 24};
+            std::vector<cv::Mat> planes;
+            auto                 padded = PadPlanes(img, pad, planes);
+            CHECK(padded.Check().empty());
+            CHECK(padded.step[0] > (size_t)padded.width);
+            CHECK_EQ(CompareRows(padded, ref), 0);
+            // FromMat引用更宽图像的子区域(行跨度大于宽度，I420要求连续不适用)
+            if (it.format != Tools::YUVImage::FORMAT_I420) {
+                cv::Mat wide(it.mat.rows, it.mat.cols + 10, it.mat.type(), cv::Scalar::all(0xAA));
+                cv::Mat roi = wide(cv::Rect(0, 0, it.mat.cols, it.mat.rows));
+                it.mat.copyTo(roi);
+                auto sub = Tools::YUVImage::FromMat(roi, it.format);
+                CHECK(sub.Check().empty());
+                CHECK_EQ(CompareRows(sub, ref), 0);
+            }
+            // 与 cvtColor + ImageBGRToNCHW 完全一致
+            std::string                   err;
+            std::vector<Tools::Letterbox> lets;
+            auto                          expect = Tools::ImageBGRToNCHW({ref}, cv::Size(48, 40), lets, err, 1 / 255.0f);
+            CHECK(err.empty());
+            auto out = Tools::YUVToNCHW({padded}, cv::Size(48, 40), lets, err, 1 / 255.0f);
+            CHECK(err.empty());
+            CHECK(out.Size() != 0 && out.Equal(expect));
+        }
+    }
+    // 参数检查
+    {
+        std::vector<uint8_t> buf(64 * 48 * 2);
+        Tools::YUVImage      img;
+        img.format  = Tools::YUVImage::FORMAT_NV12;
+        img.width   = 64;
+        img.height  = 48;
+        img.data[0] = buf.data();
+        img.data[1] = buf.data() + 64 * 48;
+        img.step[0] = 64;
+        img.step[1] = 64;
+        CHECK(img.Check().empty());
+        img.step[1] = 62;
+        CHECK(!img.Check().empty());   // 行跨度不足
+        img.step[1] = 64;
+        img.width   = 63;
+        CHECK(!img.Check().empty());   // 宽度为奇数
+        img.width   = 64;
+        img.data[1] = nullptr;
+        CHECK(!img.Check().empty());   // 缺少平面
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                ImageReader
+// --------------------------------------------------------------------------------
+
+static void ImageReader_test()
+{
+    char tmp[] = "/tmp/test_cv.XXXXXX";
+    CHECK(mkdtemp(tmp) != nullptr);
+    std::string root = tmp;
+    std::string good = root + "/good.jpg";
+    std::string bad  = root + "/bad.jpg";   // 不是图像
+    CHECK(cv::imwrite(good, SmoothImage(240, 320)));
+    FILE *fp = fopen(bad.c_str(), "wb");
+    if (fp != nullptr) {
+        fputs("not a picture", fp);
+        fclose(fp);
+    }
+    // 读取失败的文件返回空图像，不阻塞后续图片
+    strings files = {good, bad, root + "/none.jpg", good, bad, good};
+    for (int reduced = 0; reduced < 2; reduced++) {
+        Tools::ImageReader        reader(files, 2, 2, reduced ? cv::Size2i(160, 160) : cv::Size2i());
+        Tools::ImageReader::Frame frame;
+        size_t                    count = 0;
+        while (reader.Next(frame)) {
+            CHECK_EQ(frame.index, count);
+            CHECK(frame.path == files[count]);
+            if (frame.path == good) {
+                CHECK(!frame.img.empty());
+                CHECK(frame.original == cv::Size(320, 240));
+            } else {
+                CHECK(frame.img.empty());
+            }
+            count++;
+        }
+        CHECK_EQ(count, files.size());
+    }
+    unlink(good.c_str());
+    unlink(bad.c_str());
+    rmdir(root.c_str());
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                Letterbox::Restore
+// --------------------------------------------------------------------------------
+
+static bool Near(float a, float b)
+{
+    return fabsf(a - b) <= 1e-3f;
+}
+
+static void LetterboxRestore_test()
+{
+    // 640x480 -> 320x320: 缩放0.5，上下各填充40
+    auto  let  = Tools::Letterbox::Create(cv::Size(640, 480), 320, 320);
+    float r    = 0.5f;
+    float left = 0;
+    float top  = 40;
+    // 单个盒子/坐标点
+    {
+        cv::Rect src(100, 60, 200, 100);
+        cv::Rect box(src.x * r + left, src.y * r + top, src.width * r, src.height * r);
+        CHECK(let.Restore(box) == src);
+        CHECK(let.Restore(cv::Point(50, 70)) == cv::Point(100, 60));
+        // 填充区域内的部分限制在图像内
+        CHECK(let.Restore(cv::Rect(200, 250, 200, 100)) == cv::Rect(400, 420, 240, 60));
+        CHECK(let.Restore(cv::Point(400, 400)) == cv::Point(640, 480));
+    }
+    // 批量盒子: XYWH/XYXY，行跨度大于4(后面为置信度等)，原地还原
+    {
+        const size_t stride  = 6;
+        float        boxes[] = {
+            50, 70, 100, 50, 0.9f, 1,       // 图像内
+            -20, 20, 60, 40, 0.8f, 2,       // 左上超出
+            300, 270, 40, 60, 0.7f, 3,      // 右下超出
+            10.5f, 41, 0.5f, 0.25f, 0, 0,   // 小数
+        };
+        float expect_xywh[] = {
+            100, 60, 200, 100,
+            0, 0, 80, 40,
+            600, 460, 40, 20,
+            21, 2, 1, 0.5f,
+        };
+        const size_t count = sizeof(boxes) / sizeof(float) / stride;
+        float        out[count * 4];
+        let.RestoreBoxes(boxes, count, stride, Tools::Letterbox::BOX_XYWH, out);
+        for (size_t i = 0; i < count * 4; i++)
+            CHECK(Near(out[i], expect_xywh[i]));
+        // 与逐个还原一致(整数截断误差内)
+        for (size_t i = 0; i < count; i++) {
+            auto *p   = boxes + i * stride;
+            auto  one = let.Restore(cv::Rect(p[0], p[1], p[2], p[3]));
+            CHECK(fabsf(one.x - out[i * 4 + 0]) <= 2 && fabsf(one.y - out[i * 4 + 1]) <= 2);
+        }
+        // XYXY
+        float xyxy[count * stride];
+        for (size_t i = 0; i < count; i++) {
+            float *p = boxes + i * stride;
+            float *d = xyxy + i * stride;
+            d[0]     = p[0];
+            d[1]     = p[1];
+            d[2]     = p[0] + p[2];
+            d[3]     = p[1] + p[3];
+            d[4]     = p[4];
+            d[5]     = p[5];
+        }
+        let.RestoreBoxes(xyxy, count, stride, Tools::Letterbox::BOX_XYXY, xyxy);
+        for (size_t i = 0; i < count; i++) {
+            const float *e = expect_xywh + i * 4;
+            const float *d = xyxy + i * 4;
+            CHECK(Near(d[0], e[0]) && Near(d[1], e[1]) && Near(d[2], e[0] + e[2]) && Near(d[3], e[1] + e[3]));
+        }
+    }
+    // 批量坐标点: 关键点(x,y,置信度)，原地还原
+    {
+        float pts[] = {
+            50, 70, 0.9f,
+            0, 0, 0.8f,
+            320, 320, 0.7f,
+            160.25f, 160.5f, 0.6f,
+        };
+        float expect[] = {
+            100, 60,
+            0, 0,
+            640, 480,
+            320.5f, 241,
+        };
+        let.RestorePoints(pts, 4, 3, pts);
+        for (size_t i = 0; i < 8; i++)
+            CHECK(Near(pts[i], expect[i]));
+    }
+    // 缩小解码: 处理的是320x240的图像，还原到640x480原图像
+    {
+        auto reduced = Tools::Letterbox::Create(cv::Size(320, 240), 320, 320);
+        reduced.Rescale(cv::Size(640, 480));
+        CHECK_EQ(reduced.width, 640);
+        CHECK_EQ(reduced.height, 480);
+        float box[4] = {50, 70, 100, 50};
+        reduced.RestoreBoxes(box, 1, 4, Tools::Letterbox::BOX_XYWH, box);
+        CHECK(Near(box[0], 100) && Near(box[1], 60) && Near(box[2], 200) && Near(box[3], 100));
+        CHECK(reduced.Restore(cv::Rect(50, 70, 100, 50)) == cv::Rect(100, 60, 200, 100));
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                ImageBGRToNCHW
+// --------------------------------------------------------------------------------
+
+static void ImageBGRToNCHW_test()
+{
+    cv::Size          size(640, 640);
+    Tools::ThreadPool pool(4);
+    // 单张图片按行分块、多张图片按图片分块，结果与串行处理完全相同
+    std::vector<std::vector<cv::Mat>> batches = {
+        {SmoothImage(720, 1280)},
+        {SmoothImage(720, 1280), SmoothImage(1280, 720), SmoothImage(333, 517), SmoothImage(640, 640), SmoothImage(100, 1000)},
+    };
+    for (auto &imgs : batches) {
+        std::vector<Tools::Letterbox> serial_lets, pool_lets;
+        std::string                   serial_err, pool_err;
+        auto                          serial = Tools::ImageBGRToNCHW(imgs, size, serial_lets, serial_err, 1 / 255.0f);
+        auto                          para   = Tools::ImageBGRToNCHW(imgs, size, pool_lets, pool_err, 1 / 255.0f, &pool);
+        CHECK(serial_err.empty() && pool_err.empty());
+        CHECK(serial.GetShape() == para.GetShape());
+        CHECK(serial.Size() == para.Size() && memcmp(serial.Value(), para.Value(), serial.Size() * sizeof(float)) == 0);
+        // 变换信息按图片顺序
+        CHECK_EQ(pool_lets.size(), imgs.size());
+        for (size_t i = 0; i < imgs.size() && i < pool_lets.size(); i++) {
+            CHECK_EQ(pool_lets[i].width, imgs[i].cols);
+            CHECK_EQ(pool_lets[i].height, imgs[i].rows);
+            CHECK(pool_lets[i].Restore(cv::Point(320, 320)) == serial_lets[i].Restore(cv::Point(320, 320)));
+        }
+    }
+    // 追加到已有的变换信息之后，写入已分配内存中各自的位置
+    {
+        auto                          &imgs = batches[1];
+        std::vector<Tools::Letterbox> lets(1);
+        std::vector<float>            dst(imgs.size() * size.area() * 3, -1);
+        CHECK(Tools::ImageBGRToNCHW(imgs, size, dst.data(), lets, 1 / 255.0f, &pool).empty());
+        CHECK_EQ(lets.size(), imgs.size() + 1);
+        for (size_t i = 0; i < imgs.size(); i++) {
+            std::vector<Tools::Letterbox> one;
+            std::string                   err;
+            auto                          ref = Tools::ImageBGRToNCHW({imgs[i]}, size, one, err, 1 / 255.0f);
+            CHECK(memcmp(ref.Value(), dst.data() + i * ref.Size(), ref.Size() * sizeof(float)) == 0);
+            CHECK(lets.size() > i + 1 && lets[i + 1].width == imgs[i].cols && lets[i + 1].height == imgs[i].rows);
+        }
+    }
+    // 在执行器唯一的工作线程中调用: 未开始的块由当前线程处理，不会死锁
+    {
+        Tools::ThreadPool             single(1);
+        std::promise<bool>            promise;
+        std::vector<Tools::Letterbox> serial_lets;
+        std::string                   serial_err;
+        auto                          serial = Tools::ImageBGRToNCHW(batches[0], size, serial_lets, serial_err, 1 / 255.0f);
+        single.Post([&] {
+            std::vector<Tools::Letterbox> lets;
+            std::string                   err;
+            auto                          para = Tools::ImageBGRToNCHW(batches[0], size, lets, err, 1 / 255.0f, &single);
+            promise.set_value(err.empty() && memcmp(serial.Value(), para.Value(), serial.Size() * sizeof(float)) == 0);
+        });
+        auto future = promise.get_future();
+        bool ready  = future.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+        CHECK(ready);
+        CHECK(ready && future.get());
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                Letterbox::AutoSize
+// --------------------------------------------------------------------------------
+
+static void AutoSize_test()
+{
+    // 16:9 按最大目标大小缩放后只填充到步长的整数倍
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(1280, 720)}, 640, 640, 32) == cv::Size(640, 384));
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(720, 1280)}, 640, 640, 32) == cv::Size(384, 640));
+    // 批量时取能容纳所有图像的最小公共大小
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(1280, 720), cv::Size(640, 480)}, 640, 640, 32) == cv::Size(640, 480));
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(1280, 720), cv::Size(720, 1280)}, 640, 640, 32) == cv::Size(640, 640));
+    // 最大目标大小不是步长的整数倍时不超过最大目标大小(600x338 -> 600x352)
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(1280, 720)}, 600, 600, 32) == cv::Size(600, 352));
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(720, 1280)}, 600, 600, 32) == cv::Size(352, 600));
+    // 忽略空图像，没有非空图像时为0x0
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(), cv::Size(1280, 720)}, 640, 640, 32) == cv::Size(640, 384));
+    CHECK(Tools::Letterbox::AutoSize({cv::Size(), cv::Size()}, 640, 640, 32) == cv::Size(0, 0));
+    CHECK(Tools::Letterbox::AutoSize({}, 640, 640, 32) == cv::Size(0, 0));
+    // 转换为张量并还原盒子
+    {
+        std::vector<Tools::Letterbox> lets;
+        std::string                   err;
+        auto                          data = Tools::ImageBGRToNCHWAuto({SmoothImage(720, 1280)}, cv::Size(640, 640), 32, lets, err, 1 / 255.0f);
+        CHECK(err.empty());
+        CHECK(data.GetShape() == std::vector<int>({1, 3, 384, 640}));
+        CHECK(lets.size() == 1 && lets[0].let_width == 640 && lets[0].let_height == 384);
+        // 缩放0.5，上下各填充12行
+        float box[4] = {50, 112, 150, 50};
+        if (lets.size() == 1)
+            lets[0].RestoreBoxes(box, 1, 4, Tools::Letterbox::BOX_XYWH, box);
+        CHECK(Near(box[0], 100) && Near(box[1], 200) && Near(box[2], 300) && Near(box[3], 100));
+    }
+    // 批量大小由最大的图像决定，较小的图像在公共大小内居中
+    {
+        std::vector<Tools::Letterbox> lets;
+        std::string                   err;
+        auto                          data = Tools::ImageBGRToNCHWAuto({SmoothImage(720, 1280), SmoothImage(480, 640)}, cv::Size(640, 640), 32, lets, err);
+        CHECK(err.empty());
+        CHECK(data.GetShape() == std::vector<int>({2, 3, 480, 640}));
+        CHECK(lets.size() == 2);
+        CHECK(lets.size() == 2 && lets[0].Restore(cv::Point(320, 240)) == cv::Point(640, 360));
+        CHECK(lets.size() == 2 && lets[1].Restore(cv::Point(320, 240)) == cv::Point(320, 240));
+    }
+    // 全部为空时直接返回错误
+    {
+        std::vector<Tools::Letterbox> lets;
+        std::string                   err;
+        auto                          data = Tools::ImageBGRToNCHWAuto({cv::Mat(), cv::Mat()}, cv::Size(640, 640), 32, lets, err);
+        CHECK(err == "The picture cannot be empty");
+        CHECK(data.Size() == 0 && lets.empty());
+        err.clear();
+        Tools::ImageBGRToNCHWAuto(std::vector<cv::Mat>(), cv::Size(640, 640), 32, lets, err);
+        CHECK(err == "The picture cannot be empty");
+    }
+    return;
+}
+
+int main()
+{
+    LetterboxMake_test();
+    LetterboxRestore_test();
+    LetterboxMap_test();
+    YUV_test();
+    ImageReader_test();
+    ImageBGRToNCHW_test();
+    AutoSize_test();
+    return Test::Report("test_cv");
+}
@@ -0,0 +1,135 @@
+/**
+ * @file     test_detection.cpp
+ * @brief    TargetDetection 测试
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "TargetDetection.hpp"
+
+using namespace AIMethod;
+
+/**
+ * @brief    图块内的检测结果
+ * @param    box            盒子(整图坐标)
+ * @param    tile           图块
+ */
+static TargetDetection::Result Box(int classId, float confidence, const cv::Rect &box, const cv::Rect &tile)
+{
+    TargetDetection::Result r;
+    r._index     = 0;
+    r.classId    = classId;
+    r.confidence = confidence;
+    r.box        = box - tile.tl();
+    return r;
+}
+
+/**
+ * @brief    结果中是否有该盒子
+ */
+static bool Has(const std::vector<TargetDetection::Result> &rs, const cv::Rect &box)
+{
+    for (auto &r : rs) {
+        if (r.box == box)
+            return true;
+    }
+    return false;
+}
+
+// --------------------------------------------------------------------------------
+//                                MergeTiles
+// --------------------------------------------------------------------------------
+
+static void MergeTiles_test()
+{
+    // 整图 1152x640: 两个重叠128像素的图块 + 整图缩小的图块
+    std::vector<cv::Rect> tiles = {{0, 0, 640, 640}, {512, 0, 640, 640}, {0, 0, 1152, 640}};
+    TargetDetection       det;
+    // 重叠区内的完整目标在两个图块中各检测一次
+    {
+        cv::Rect                                          box(550, 100, 50, 50);
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[0].push_back(Box(0, 0.9f, box, tiles[0]));
+        results[1].push_back(Box(0, 0.8f, box + cv::Point(1, 1), tiles[1]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 1);
+        CHECK(Has(rs, box));
+    }
+    // 跨越图块边界的目标: 截断的部分盒子置信度更高，仍保留完整盒子
+    {
+        cv::Rect                                          full(600, 200, 400, 60);
+        cv::Rect                                          part(600, 200, 40, 60);   // 贴近图块0右边
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[0].push_back(Box(0, 0.9f, part, tiles[0]));
+        results[1].push_back(Box(0, 0.6f, full, tiles[1]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 1);
+        CHECK(Has(rs, full));
+    }
+    // 同一图块内嵌套的同类目标(已做过NMS)
+    {
+        cv::Rect                                          big(100, 100, 300, 300);
+        cv::Rect                                          small(150, 150, 50, 50);
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[0].push_back(Box(0, 0.9f, big, tiles[0]));
+        results[0].push_back(Box(0, 0.8f, small, tiles[0]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 2);
+    }
+    // 整图图块的大目标中嵌套另一图块内的完整小目标
+    {
+        cv::Rect                                          big(50, 50, 400, 400);
+        cv::Rect                                          small(200, 200, 40, 40);
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[2].push_back(Box(0, 0.9f, big, tiles[2]));
+        results[0].push_back(Box(0, 0.8f, small, tiles[0]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 2);
+        CHECK(Has(rs, big) && Has(rs, small));
+    }
+    // 整图图块与普通图块检测到同一目标
+    {
+        cv::Rect                                          box(100, 300, 120, 80);
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[2].push_back(Box(0, 0.7f, box + cv::Point(3, -2), tiles[2]));
+        results[0].push_back(Box(0, 0.9f, box, tiles[0]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 1);
+        CHECK(Has(rs, box));
+    }
+    // 不同类别不去重
+    {
+        cv::Rect                                          box(550, 100, 50, 50);
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[0].push_back(Box(0, 0.9f, box, tiles[0]));
+        results[1].push_back(Box(1, 0.8f, box, tiles[1]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 2);
+    }
+    // 图像边缘上的盒子不视为截断
+    {
+        cv::Rect                                          edge(0, 500, 60, 140);
+        cv::Rect                                          nested(0, 600, 20, 40);
+        std::vector<std::vector<TargetDetection::Result>> results(3);
+        results[2].push_back(Box(0, 0.9f, edge, tiles[2]));
+        results[0].push_back(Box(0, 0.8f, nested, tiles[0]));
+        auto rs = det.MergeTiles(results, tiles);
+        CHECK_EQ(rs.size(), 2);
+    }
+    return;
+}
+
+int main()
+{
+    MergeTiles_test();
+    return Test::Report("test_detection");
+}
@@ -0,0 +1,887 @@
+/**
+ * @file     test_engine.cpp
+ * @brief    推理接口公共部分(调度/完成通知)测试
+ * @note     使用模拟引擎，不加载模型
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "Ratiocinate.hpp"
+#include "Pipeline.hpp"
+#include <condition_variable>
+
+using namespace AIMethod;
+
+/**
+ * @brief    模拟引擎(在线程池中执行，输出与输入相同)
+ */
+class FakeEngine : public IRatiocinate {
+private:
+    class Status : public IStatus {};
+
+    Tools::ThreadPool pool;
+
+protected:
+    virtual std::string Dispatch(IStatus *status) override
+    {
+        if (this->fail_dispatch)
+            return "Dispatch failed";
+        {
+            std::lock_guard<std::mutex> lock(this->log_mutex);
+            this->dispatched.push_back(status->priority);
+        }
+        this->pool.Post([this, status] {
+            // 暂停时不开始执行，保持后续任务排队
+            while (this->paused)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            status->start_ns = Tools::GetNanosecond();
+            auto running     = this->running.fetch_add(1) + 1;
+            auto peak        = this->peak.load();
+            while (running > peak && !this->peak.compare_exchange_weak(peak, running)) {}
+            std::vector<Result> outputs;
+            for (auto &data : status->input_datas)
+                outputs.push_back(data.Float());
+            // 抖动时耗时随输入值变化，使完成顺序与提交顺序不同
+            int us = this->run_us;
+            if (this->jitter && !outputs.empty() && outputs[0].Size() > 0)
+                us *= 1 + (int)outputs[0].Value()[0] % 3;
+            std::this_thread::sleep_for(std::chrono::microseconds(us));
+            this->running.fetch_sub(1);
+            this->RecordRun(status);
+            this->DisarmCancel(status);
+            this->Finish();
+            this->Notify(status, $(outputs), std::string());
+            delete status;
+            this->is_runing.fetch_sub(1);
+        });
+        return std::string();
+    }
+
+public:
+    std::atomic<int>      run_us;          // 模拟执行耗时
+    std::atomic<bool>     fail_dispatch;   // 模拟提交失败
+    std::atomic<bool>     paused;          // 暂停执行(已提交的任务等待)
+    std::atomic<bool>     jitter;          // 执行耗时按输入值变化(run_us的1~3倍)
+    std::atomic<int>      running;         // 正在执行的任务数
+    std::atomic<int>      peak;            // 同时执行的最大任务数
+    std::mutex            log_mutex;
+    std::vector<Priority> dispatched;      // 已提交执行的任务优先级(按提交顺序)
+
+    FakeEngine(int threads, const Scheduling &scheduling) :
+        pool(threads), run_us(1000), fail_dispatch(false), paused(false), jitter(false), running(0), peak(0)
+    {
+        this->SetScheduling(scheduling, 1, threads);
+        return;
+    }
+
+    virtual ~FakeEngine()
+    {
+        this->DropQueued();
+        this->WaitIdle();
+        return;
+    }
+
+    size_t Dispatched()
+    {
+        std::lock_guard<std::mutex> lock(this->log_mutex);
+        return this->dispatched.size();
+    }
+
+    virtual bool IsRun() override
+    {
+        return this->is_runing != 0;
+    }
+
+    virtual std::string LoadModel(const Parameters &params) override
+    {
+        return std::string();
+    }
+
+    virtual std::string Prepare(const std::vector<std::string>      &input_names,
+                                const std::vector<std::string>      &output_names,
+                                const std::vector<std::vector<int>> &shapes,
+                                Binding                             &binding) override
+    {
+        auto bd  = std::make_shared<IBinding>();
+        auto err = InitBinding(*bd, input_names, output_names, shapes);
+        if (err.empty())
+            binding = bd;
+        return err;
+    }
+
+    using IRatiocinate::ExecAsync;
+
+    virtual std::string ExecAsync(const Binding            &binding,
+                                  const std::vector<Input> &input_datas,
+                                  const ExecOptions        &options) override
+    {
+        auto status         = new Status();
+        status->infer       = this;
+        status->submit_ns   = Tools::GetNanosecond();
+        status->binding     = binding;
+        status->input_datas = input_datas;
+        status->priority    = options.priority;
+        status->done        = options.done;
+        status->executor    = options.executor;
+        auto err            = this->ArmCancel(status, options);
+        if (err.empty()) {
+            this->is_runing.fetch_add(1);
+            err = this->Enqueue(status);
+            if (!err.empty()) {
+                this->DisarmCancel(status);
+                this->is_runing.fetch_sub(1);
+            }
+        }
+        if (!err.empty()) {
+            delete status;
+            this->Notify(binding, input_datas, std::vector<Result>(), err, options.done, options.executor);
+        }
+        return err;
+    }
+};
+
+/**
+ * @brief    拒绝所有任务的执行器
+ */
+class RejectExecutor : public Tools::IExecutor {
+public:
+    virtual bool Post(std::function<void()> task) override
+    {
+        return false;
+    }
+};
+
+static IRatiocinate::Binding MakeBinding(IRatiocinate &infer)
+{
+    IRatiocinate::Binding binding;
+    infer.Prepare({"input"}, {"output"}, {{1, 4}}, binding);
+    return binding;
+}
+
+static Tensor<float> MakeInput(float value)
+{
+    Tensor<float> data({1, 4});
+    for (size_t i = 0; i < data.Size(); i++)
+        data.Value()[i] = value;
+    return data;
+}
+
+// --------------------------------------------------------------------------------
+//                                完成通知
+// --------------------------------------------------------------------------------
+
+static void Notify_test()
+{
+    IRatiocinate::Scheduling scheduling;
+    FakeEngine               infer(2, scheduling);
+    auto                     binding = MakeBinding(infer);
+    // 执行器拒绝时在当前线程回调，输出不能丢失
+    {
+        RejectExecutor            executor;
+        std::promise<size_t>      promise;
+        std::atomic<int>          calls(0);
+        IRatiocinate::ExecOptions options;
+        options.executor = &executor;
+        options.done     = [&](const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            if (calls++ == 0)
+                promise.set_value(err.empty() && outputs.size() == 1 ? outputs[0].Size() : 0);
+        };
+        infer.ExecAsync(binding, {MakeInput(1)}, options);
+        CHECK_EQ(promise.get_future().get(), 4);
+        while (infer.IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK_EQ(calls.load(), 1);
+    }
+    // 执行器接受时在执行器中回调
+    {
+        Tools::ThreadPool         executor(1);
+        std::promise<bool>        promise;
+        IRatiocinate::ExecOptions options;
+        options.executor = &executor;
+        options.done     = [&](const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            promise.set_value(err.empty() && outputs.size() == 1 && outputs[0].Value()[0] == 2);
+        };
+        infer.ExecAsync(binding, {MakeInput(2)}, options);
+        CHECK(promise.get_future().get());
+        // 执行器需在任务结束后才能销毁
+        while (infer.IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // 执行器中排队的回调晚于推理接口销毁
+    {
+        Tools::CompletionExecutor executor(0, 16, nullptr);
+        std::vector<std::string>  errs;
+        IRatiocinate::ExecOptions options;
+        auto                      engine = new FakeEngine(1, scheduling);
+        auto                      bd     = MakeBinding(*engine);
+        engine->run_us                   = 50000;
+        options.executor                 = &executor;
+        options.done                     = [&](const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            errs.push_back(err);
+        };
+        // 第一个执行完成，第二个排队中被销毁取消
+        engine->ExecAsync(bd, {MakeInput(4)}, options);
+        engine->ExecAsync(bd, {MakeInput(5)}, options);
+        delete engine;
+        CHECK_EQ(executor.Pending(), 2);
+        CHECK_EQ(executor.Poll(), 2);
+        CHECK(errs.size() == 2 && errs[0] == ERR_RATIOCINATE_CANCELED && errs[1].empty());
+    }
+    // future
+    {
+        auto reply = infer.ExecFuture(binding, {MakeInput(3)}).get();
+        CHECK(reply.err.empty());
+        CHECK(reply.outputs.size() == 1 && reply.outputs[0].Value()[0] == 3);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                调度
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief    记录回调结果
+ */
+class Recorder {
+public:
+    std::mutex               mutex;
+    std::condition_variable  cond;
+    std::vector<std::string> errs;
+    std::vector<uint64_t>    times;
+
+    explicit Recorder(size_t count)
+    {
+        // 回调写入时不能重新分配
+        this->errs.reserve(count);
+        this->times.reserve(count);
+        return;
+    }
+
+    IRatiocinate::ExecOptions Options()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        IRatiocinate::ExecOptions   options;
+        auto                        index = this->errs.size();
+        this->errs.push_back("pending");
+        this->times.push_back(0);
+        options.done = [this, index](const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->errs[index]  = err;
+            this->times[index] = Tools::GetNanosecond();
+            this->cond.notify_all();
+        };
+        return options;
+    }
+
+    bool Wait(size_t index, uint64_t timeout_ms)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        return this->cond.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this, index] { return this->times[index] != 0; });
+    }
+};
+
+static void Schedule_test()
+{
+    // 排队中的任务到期时立即回调，不等待下一次提交或完成
+    {
+        IRatiocinate::Scheduling scheduling;
+        FakeEngine               infer(1, scheduling);
+        Recorder                 rec(2);
+        auto                     binding = MakeBinding(infer);
+        infer.run_us                     = 200000;
+        infer.ExecAsync(binding, {MakeInput(1)}, rec.Options());
+        auto options        = rec.Options();
+        options.deadline_ns = Tools::GetNanosecond() + 10000000ULL;
+        infer.ExecAsync(binding, {MakeInput(2)}, options);
+        CHECK(rec.Wait(1, 100));
+        CHECK(rec.errs[1] == ERR_RATIOCINATE_DEADLINE);
+        CHECK(rec.times[0] == 0);   // 第一个任务仍在执行
+        CHECK(rec.Wait(0, 1000));
+        CHECK(rec.errs[0].empty());
+    }
+    // 提交失败时逐个回调，不递归调度
+    {
+        IRatiocinate::Scheduling scheduling;
+        scheduling.max_queue = 0;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(1000);
+        auto       binding = MakeBinding(infer);
+        infer.run_us       = 200000;
+        for (int i = 0; i < 1000; i++)
+            infer.ExecAsync(binding, {MakeInput(i)}, rec.Options());
+        infer.fail_dispatch = true;
+        while (infer.IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK(rec.errs[0].empty());
+        int failed = 0;
+        for (size_t i = 1; i < rec.errs.size(); i++)
+            failed += rec.errs[i] == "Dispatch failed";
+        CHECK_EQ(failed, 999);
+    }
+    // 销毁时丢弃排队任务并等待执行中的任务完成
+    {
+        IRatiocinate::Scheduling scheduling;
+        Recorder                 rec(8);
+        scheduling.max_inflight = 2;
+        auto infer              = new FakeEngine(2, scheduling);
+        auto binding            = MakeBinding(*infer);
+        infer->run_us           = 20000;
+        for (int i = 0; i < 8; i++)
+            infer->ExecAsync(binding, {MakeInput(i)}, rec.Options());
+        delete infer;
+        int done = 0, canceled = 0;
+        for (auto &err : rec.errs) {
+            done += err.empty();
+            canceled += err == ERR_RATIOCINATE_CANCELED;
+        }
+        CHECK_EQ(done, 2);
+        CHECK_EQ(canceled, 6);
+    }
+    return;
+}
+
+/**
+ * @brief    统计已提交执行的任务中各优先级的数量
+ * @param    dispatched     已提交执行的任务优先级
+ * @param    begin          起始位置
+ * @param    count          数量
+ * @param    priority       优先级
+ * @return   int
+ */
+static int CountPriority(const std::vector<IRatiocinate::Priority> &dispatched, size_t begin, size_t count, IRatiocinate::Priority priority)
+{
+    int n = 0;
+    for (size_t i = begin; i < begin + count && i < dispatched.size(); i++)
+        n += dispatched[i] == priority;
+    return n;
+}
+
+static void Pick_test()
+{
+    // 按权重分配执行次数；空闲后重新排队的优先级从当前虚拟时间开始
+    {
+        IRatiocinate::Scheduling scheduling;
+        scheduling.max_inflight  = 1;
+        scheduling.max_queue     = 64;
+        scheduling.starvation_ns = 0;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(128);
+        auto       binding = MakeBinding(infer);
+        auto       submit  = [&](IRatiocinate::Priority priority, int count) {
+            for (int i = 0; i < count; i++) {
+                auto options     = rec.Options();
+                options.priority = priority;
+                CHECK(infer.ExecAsync(binding, {MakeInput(i)}, options).empty());
+            }
+        };
+        auto run = [&](size_t total) {
+            infer.paused = false;
+            while (infer.IsRun())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            infer.paused = true;
+            CHECK_EQ(infer.Dispatched(), total);
+        };
+        // 第一个任务占用执行位置，其余排队
+        infer.paused = true;
+        submit(IRatiocinate::PRIORITY_REALTIME, 1);
+        submit(IRatiocinate::PRIORITY_REALTIME, 32);
+        submit(IRatiocinate::PRIORITY_INTERACTIVE, 8);
+        submit(IRatiocinate::PRIORITY_BATCH, 2);
+        run(43);
+        // 同一优先级按提交顺序完成(序号33、41为交互、批处理的第一个任务)
+        bool ordered = true;
+        for (size_t i = 2; i < rec.times.size(); i++) {
+            if (i != 33 && i != 41)
+                ordered = ordered && rec.times[i - 1] < rec.times[i];
+        }
+        CHECK(ordered);
+        {
+            auto &log = infer.dispatched;
+            CHECK(log.size() == 43 && log[1] == IRatiocinate::PRIORITY_INTERACTIVE && log[2] == IRatiocinate::PRIORITY_BATCH);
+            for (size_t begin = 1; begin < 43; begin += 21) {
+                CHECK_EQ(CountPriority(log, begin, 21, IRatiocinate::PRIORITY_REALTIME), 16);
+                CHECK_EQ(CountPriority(log, begin, 21, IRatiocinate::PRIORITY_INTERACTIVE), 4);
+                CHECK_EQ(CountPriority(log, begin, 21, IRatiocinate::PRIORITY_BATCH), 1);
+            }
+        }
+        // 只有实时任务时其他优先级的虚拟时间落后
+        submit(IRatiocinate::PRIORITY_REALTIME, 32);
+        run(75);
+        // 交互任务重新排队后不能连续执行补回空闲期间的配额，仍按4:1交替
+        submit(IRatiocinate::PRIORITY_REALTIME, 1);
+        submit(IRatiocinate::PRIORITY_INTERACTIVE, 4);
+        submit(IRatiocinate::PRIORITY_REALTIME, 16);
+        run(96);
+        {
+            auto &log = infer.dispatched;
+            for (size_t i = 76; i < log.size(); i++) {
+                auto expect = (i - 76) % 5 == 0 ? IRatiocinate::PRIORITY_INTERACTIVE : IRatiocinate::PRIORITY_REALTIME;
+                CHECK(log[i] == expect);
+            }
+        }
+        infer.paused = false;
+    }
+    // 防饥饿: 低优先级任务等待超过starvation_ns后提前执行
+    {
+        IRatiocinate::Scheduling scheduling;
+        scheduling.max_inflight  = 1;
+        scheduling.max_queue     = 64;
+        scheduling.starvation_ns = 20000000ULL;
+        scheduling.weights[0]    = 1000;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(64);
+        auto       binding = MakeBinding(infer);
+        infer.run_us       = 2000;
+        // 批处理任务先执行一次，虚拟时间领先实时任务1000次
+        auto options     = rec.Options();
+        options.priority = IRatiocinate::PRIORITY_BATCH;
+        infer.ExecAsync(binding, {MakeInput(0)}, options);
+        CHECK(rec.Wait(0, 1000));
+        while (infer.IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        infer.paused = true;
+        options      = rec.Options();
+        infer.ExecAsync(binding, {MakeInput(1)}, options);
+        options          = rec.Options();
+        options.priority = IRatiocinate::PRIORITY_BATCH;
+        auto submit_ns   = Tools::GetNanosecond();
+        infer.ExecAsync(binding, {MakeInput(2)}, options);
+        for (int i = 0; i < 60; i++) {
+            options = rec.Options();
+            infer.ExecAsync(binding, {MakeInput(i)}, options);
+        }
+        infer.paused = false;
+        CHECK(rec.Wait(2, 1000));
+        // 执行开始不晚于 starvation_ns 加一个任务的执行时间(允许调度抖动)
+        CHECK(rec.times[2] - submit_ns < 2 * scheduling.starvation_ns);
+        while (infer.IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        size_t position = 0;
+        for (size_t i = 2; i < infer.dispatched.size(); i++) {
+            if (infer.dispatched[i] == IRatiocinate::PRIORITY_BATCH)
+                position = i;
+        }
+        CHECK(position > 2 && position < 40);
+    }
+    return;
+}
+
+/**
+ * @brief    提交任务
+ * @param    infer          推理接口
+ * @param    binding        绑定
+ * @param    rec            回调结果
+ * @param    count          数量
+ * @param    priority       优先级
+ * @return   std::string    各任务同步返回的错误(用 '.' 表示成功，'D' 表示丢弃，'?' 表示其他)
+ */
+static std::string Submit(FakeEngine                  &infer,
+                          const IRatiocinate::Binding &binding,
+                          Recorder                    &rec,
+                          int                          count,
+                          IRatiocinate::Priority       priority = IRatiocinate::PRIORITY_INTERACTIVE)
+{
+    std::string rs;
+    for (int i = 0; i < count; i++) {
+        auto options     = rec.Options();
+        options.priority = priority;
+        auto err         = infer.ExecAsync(binding, {MakeInput(i)}, options);
+        rs += err.empty() ? '.' : (err == ERR_RATIOCINATE_DROPPED ? 'D' : '?');
+    }
+    return rs;
+}
+
+/**
+ * @brief    等待所有任务结束并返回回调结果(用 '.' 表示成功，'D' 表示丢弃，'?' 表示其他)
+ * @param    infer          推理接口
+ * @param    rec            回调结果
+ * @return   std::string
+ */
+static std::string Drain(FakeEngine &infer, Recorder &rec)
+{
+    infer.paused = false;
+    while (infer.IsRun())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::string rs;
+    for (auto &err : rec.errs)
+        rs += err.empty() ? '.' : (err == ERR_RATIOCINATE_DROPPED ? 'D' : '?');
+    return rs;
+}
+
+static void Overload_test()
+{
+    IRatiocinate::Scheduling scheduling;
+    scheduling.max_inflight  = 1;
+    scheduling.max_queue     = 2;
+    scheduling.starvation_ns = 0;
+    // 第一个任务暂停在执行中，之后的任务排队(每个优先级最多2个)
+    // 丢弃新任务: 同步返回，排队的任务不受影响；各优先级独立计数
+    {
+        scheduling.overload = IRatiocinate::OVERLOAD_DROP_NEWEST;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(16);
+        auto       binding = MakeBinding(infer);
+        infer.paused       = true;
+        infer.run_us       = 5000;
+        CHECK(Submit(infer, binding, rec, 5) == "...DD");
+        CHECK(Submit(infer, binding, rec, 3, IRatiocinate::PRIORITY_REALTIME) == "..D");
+        CHECK(Drain(infer, rec) == "...DD..D");
+        auto stat = infer.GetStatistics();
+        CHECK_EQ(stat.dropped[IRatiocinate::PRIORITY_REALTIME], 1);
+        CHECK_EQ(stat.dropped[IRatiocinate::PRIORITY_INTERACTIVE], 2);
+        CHECK_EQ(stat.dropped[IRatiocinate::PRIORITY_BATCH], 0);
+    }
+    // 丢弃最旧任务: 新任务入队，队首通过回调丢弃
+    {
+        scheduling.overload = IRatiocinate::OVERLOAD_DROP_OLDEST;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(16);
+        auto       binding = MakeBinding(infer);
+        infer.paused       = true;
+        infer.run_us       = 5000;
+        CHECK(Submit(infer, binding, rec, 5) == ".....");
+        CHECK(Drain(infer, rec) == ".DD..");
+        CHECK_EQ(infer.GetStatistics().dropped[IRatiocinate::PRIORITY_INTERACTIVE], 2);
+        CHECK_EQ(infer.Dispatched(), 3);
+    }
+    // 只保留最新: 新任务入队时丢弃同优先级的全部排队任务
+    {
+        scheduling.overload = IRatiocinate::OVERLOAD_KEEP_LATEST;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(16);
+        auto       binding = MakeBinding(infer);
+        infer.paused       = true;
+        infer.run_us       = 5000;
+        CHECK(Submit(infer, binding, rec, 4) == "....");
+        CHECK(Submit(infer, binding, rec, 1, IRatiocinate::PRIORITY_BATCH) == ".");
+        CHECK(Drain(infer, rec) == ".DD..");
+        auto stat = infer.GetStatistics();
+        CHECK_EQ(stat.dropped[IRatiocinate::PRIORITY_INTERACTIVE], 2);
+        CHECK_EQ(stat.dropped[IRatiocinate::PRIORITY_BATCH], 0);
+    }
+    // 自适应跳帧: 积压时跳帧间隔加倍(最大max_skip)，跳过的帧同步返回，队列满时丢弃队首；
+    // 不再积压后每接收一帧间隔减半
+    {
+        scheduling.overload = IRatiocinate::OVERLOAD_ADAPTIVE;
+        scheduling.max_skip = 8;
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(64);
+        auto       binding = MakeBinding(infer);
+        infer.paused       = true;
+        infer.run_us       = 5000;
+        // 0执行中；1入队；2入队(间隔1)；4入队丢弃1(间隔2)；7入队丢弃2(间隔4)；12入队丢弃4(间隔8)；21入队丢弃7(间隔8)
+        CHECK(Submit(infer, binding, rec, 22) == "...D.DD.DDDD.DDDDDDDD.");
+        CHECK(Drain(infer, rec) == ".DDDDDDDDDDD.DDDDDDDD.");
+        CHECK_EQ(infer.GetStatistics().dropped[IRatiocinate::PRIORITY_INTERACTIVE], 19);
+        // 逐个提交并等待完成: 跳过剩余的8帧后间隔依次减半为4、2、1、0
+        std::string sync;
+        for (int i = 0; i < 20; i++) {
+            sync += Submit(infer, binding, rec, 1);
+            while (infer.IsRun())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        CHECK(sync == "DDDDDDDD.DDDD.DD.D..");
+        CHECK_EQ(infer.GetStatistics().dropped[IRatiocinate::PRIORITY_INTERACTIVE], 34);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                取消
+// --------------------------------------------------------------------------------
+
+static void Cancel_test()
+{
+    IRatiocinate::Scheduling scheduling;
+    // 排队中取消: 下一次调度时以ERR_RATIOCINATE_CANCELED回调，不执行
+    {
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(2);
+        auto       binding = MakeBinding(infer);
+        infer.paused       = true;
+        infer.ExecAsync(binding, {MakeInput(1)}, rec.Options());
+        auto options   = rec.Options();
+        options.cancel = IRatiocinate::CancelHandle::Create();
+        CHECK(infer.ExecAsync(binding, {MakeInput(2)}, options).empty());
+        options.cancel.Cancel();
+        infer.paused = false;
+        CHECK(rec.Wait(0, 1000));
+        CHECK(rec.Wait(1, 1000));
+        CHECK(rec.errs[0].empty());
+        CHECK(rec.errs[1] == ERR_RATIOCINATE_CANCELED);
+        while (infer.IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK_EQ(infer.Dispatched(), 1);
+    }
+    // 提交时已取消或已超时: 同步返回错误并回调，不执行
+    {
+        FakeEngine infer(1, scheduling);
+        Recorder   rec(2);
+        auto       binding = MakeBinding(infer);
+        auto       options = rec.Options();
+        options.cancel     = IRatiocinate::CancelHandle::Create();
+        options.cancel.Cancel();
+        CHECK(infer.ExecAsync(binding, {MakeInput(1)}, options) == ERR_RATIOCINATE_CANCELED);
+        options             = rec.Options();
+        options.deadline_ns = Tools::GetNanosecond() - 1;
+        CHECK(infer.ExecAsync(binding, {MakeInput(2)}, options) == ERR_RATIOCINATE_DEADLINE);
+        CHECK(rec.errs[0] == ERR_RATIOCINATE_CANCELED);
+        CHECK(rec.errs[1] == ERR_RATIOCINATE_DEADLINE);
+        CHECK(!infer.IsRun());
+        CHECK_EQ(infer.Dispatched(), 0);
+    }
+    // 正常完成后截止时间定时器已解除: 到期后不再回调(也不访问已销毁的推理接口)
+    {
+        std::atomic<int>          calls(0);
+        std::string               error = "pending";
+        IRatiocinate::ExecOptions options;
+        auto                      infer   = new FakeEngine(1, scheduling);
+        auto                      binding = MakeBinding(*infer);
+        options.deadline_ns               = Tools::GetNanosecond() + 50000000ULL;
+        options.cancel                    = IRatiocinate::CancelHandle::Create();
+        options.done                      = [&](const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            if (calls++ == 0)
+                error = err;
+        };
+        CHECK(infer->ExecAsync(binding, {MakeInput(1)}, options).empty());
+        while (infer->IsRun())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        delete infer;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        CHECK_EQ(calls.load(), 1);
+        CHECK(error.empty());
+        CHECK(!options.cancel.IsCanceled());
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                流水线
+// --------------------------------------------------------------------------------
+
+/**
+ * @brief    记录后处理结果(帧为序号，推理输出为序号)
+ */
+class PostRecorder {
+public:
+    std::mutex               mutex;
+    std::vector<int>         frames;
+    std::vector<std::string> errs;
+    int                      mismatch = 0;   // 输出与帧不一致的数量
+
+    Pipeline<int>::Postprocess_t Post()
+    {
+        return [this](int &frame, const std::vector<IRatiocinate::Result> &outputs, const std::string &err) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->frames.push_back(frame);
+            this->errs.push_back(err);
+            if (err.empty() && (outputs.size() != 1 || outputs[0].Value()[0] != frame))
+                this->mismatch++;
+            if (!err.empty() && !outputs.empty())
+                this->mismatch++;
+        };
+    }
+};
+
+static void Pipeline_test()
+{
+    IRatiocinate::Scheduling scheduling;
+    scheduling.max_inflight = 4;
+    // 多个推理任务同时执行: 按提交顺序后处理，同时执行数不超过inflight；预处理失败跳过推理
+    {
+        FakeEngine                infer(4, scheduling);
+        PostRecorder              rec;
+        auto                      binding = MakeBinding(infer);
+        Pipeline<int>::Parameters params;
+        params.queue_size = 4;
+        params.inflight   = 3;
+        infer.run_us      = 2000;
+        infer.jitter      = true;
+        {
+            Pipeline<int> pipe(
+                &infer, binding,
+                [](int &frame, std::vector<IRatiocinate::Input> &inputs) {
+                    if (frame % 5 == 3)
+                        return std::string("Preprocess failed");
+                    inputs = {MakeInput(frame)};
+                    return std::string();
+                },
+                rec.Post(), params);
+            for (int i = 0; i < 40; i++)
+                CHECK(pipe.Push(i));
+            pipe.Wait();
+            CHECK(!pipe.Push(40));
+        }
+        CHECK_EQ(rec.frames.size(), 40);
+        bool ordered = true;
+        int  failed  = 0;
+        for (size_t i = 0; i < rec.frames.size(); i++) {
+            ordered = ordered && rec.frames[i] == (int)i;
+            if (rec.frames[i] % 5 == 3)
+                failed += rec.errs[i] == "Preprocess failed";
+            else
+                failed += !rec.errs[i].empty();
+        }
+        CHECK(ordered);
+        CHECK_EQ(failed, 8);
+        CHECK_EQ(rec.mismatch, 0);
+        CHECK_EQ(infer.Dispatched(), 32);
+        CHECK(infer.peak <= params.inflight);
+        CHECK(infer.peak > 1);
+    }
+    // 推理接口按过载策略丢弃: 通过完成回调进入后处理
+    {
+        IRatiocinate::Scheduling sched;
+        sched.max_inflight = 1;
+        sched.max_queue    = 1;
+        FakeEngine                infer(1, sched);
+        PostRecorder              rec;
+        auto                      binding = MakeBinding(infer);
+        Pipeline<int>::Parameters params;
+        params.inflight = 3;
+        infer.paused    = true;
+        {
+            Pipeline<int> pipe(
+                &infer, binding,
+                [](int &frame, std::vector<IRatiocinate::Input> &inputs) {
+                    inputs = {MakeInput(frame)};
+                    return std::string();
+                },
+                rec.Post(), params);
+            for (int i = 0; i < 3; i++)
+                pipe.Push(i);
+            // 第三帧提交时第一帧执行中、第二帧排队，队列已满
+            for (int i = 0; i < 1000 && infer.GetStatistics().dropped[IRatiocinate::PRIORITY_INTERACTIVE] == 0; i++)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            infer.paused = false;
+            pipe.Wait();
+        }
+        CHECK_EQ(rec.frames.size(), 3);
+        CHECK(rec.frames.size() == 3 && rec.errs[0].empty() && rec.errs[1].empty());
+        CHECK(rec.frames.size() == 3 && rec.errs[2] == ERR_RATIOCINATE_DROPPED);
+        CHECK_EQ(rec.mismatch, 0);
+        CHECK_EQ(infer.Dispatched(), 2);
+    }
+    // 未调用Wait直接销毁: 已提交的帧全部完成，不死锁
+    {
+        FakeEngine                infer(4, scheduling);
+        PostRecorder              rec;
+        auto                      binding = MakeBinding(infer);
+        Pipeline<int>::Parameters params;
+        params.inflight     = 4;
+        params.post_threads = 2;
+        infer.run_us        = 5000;
+        {
+            Pipeline<int> pipe(
+                &infer, binding,
+                [](int &frame, std::vector<IRatiocinate::Input> &inputs) {
+                    inputs = {MakeInput(frame)};
+                    return std::string();
+                },
+                rec.Post(), params);
+            for (int i = 0; i < 16; i++)
+                pipe.Push(i);
+        }
+        CHECK_EQ(rec.frames.size(), 16);
+        CHECK_EQ(rec.mismatch, 0);
+        CHECK(!infer.IsRun());
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                输入缓冲环
+// --------------------------------------------------------------------------------
+
+static void InputRing_test()
+{
+    IRatiocinate::Scheduling scheduling;
+    FakeEngine               infer(1, scheduling);
+    auto                     binding = MakeBinding(infer);
+    // 槽位全部占用后不能再取得，释放张量后槽位回到缓冲环
+    {
+        std::shared_ptr<IRatiocinate::InputRing> ring;
+        CHECK(infer.CreateInputRing(binding, 0, 3, ring).empty());
+        CHECK(ring != nullptr && ring->Idle() == 3);
+        std::vector<Tensor<float>> slots;
+        for (int i = 0; i < 3; i++) {
+            Tensor<float> tensor;
+            CHECK(ring->TryAcquire(tensor));
+            CHECK(tensor.GetShape() == binding->shapes[0]);
+            slots.push_back(tensor);
+        }
+        CHECK(slots[0].Value() != slots[1].Value() && slots[1].Value() != slots[2].Value());
+        Tensor<float> tensor;
+        CHECK(!ring->TryAcquire(tensor));
+        CHECK_EQ(ring->Idle(), 0);
+        auto released = slots[1].Value();
+        slots.erase(slots.begin() + 1);
+        CHECK_EQ(ring->Idle(), 1);
+        CHECK(ring->TryAcquire(tensor));
+        CHECK(tensor.Value() == released);
+        CHECK_EQ(ring->Idle(), 0);
+        // 全部占用时阻塞等待，其他线程释放后唤醒
+        std::atomic<bool> acquired(false);
+        std::thread       thr([&] {
+            auto slot = ring->Acquire<float>();
+            acquired  = slot.Value() == released;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(!acquired);
+        tensor = Tensor<float>();
+        thr.join();
+        CHECK(acquired);
+        // 缓冲环先于张量销毁时槽位仍然有效
+        ring = nullptr;
+        slots[0].Value()[0] = 1;
+        slots.clear();
+    }
+    // 元素类型超出槽位大小
+    {
+        std::shared_ptr<IRatiocinate::InputRing> ring;
+        CHECK(infer.CreateInputRing(binding, 0, 1, ring, IRatiocinate::Input::TYPE_UINT8).empty());
+        bool thrown = false;
+        try {
+            ring->Acquire<float>();
+        }
+        catch (std::exception &e) {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK_EQ(ring->Idle(), 1);
+    }
+    // 参数错误
+    {
+        std::shared_ptr<IRatiocinate::InputRing> ring;
+        IRatiocinate::Binding                    dynamic;
+        CHECK(infer.Prepare({"input"}, {"output"}, {{-1, 4}}, dynamic).empty());
+        CHECK(infer.CreateInputRing(dynamic, 0, 2, ring) == "The input shape must be fixed");
+        CHECK(infer.CreateInputRing(binding, 1, 2, ring) == "Invalid input index");
+        CHECK(infer.CreateInputRing(nullptr, 0, 2, ring) == "Invalid input index");
+        CHECK(infer.CreateInputRing(binding, 0, 0, ring) == "Invalid parameter");
+        CHECK(ring == nullptr);
+    }
+    return;
+}
+
+int main()
+{
+    Notify_test();
+    Schedule_test();
+    Pick_test();
+    Overload_test();
+    Cancel_test();
+    Pipeline_test();
+    InputRing_test();
+    return Test::Report("test_engine");
+}
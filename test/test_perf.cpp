@@ -0,0 +1,119 @@
+/**
+ * @file     test_perf.cpp
+ * @brief    Tools.Perf 测试
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "Tools.Thread.hpp"
+#include <math.h>
+
+/**
+ * @brief    相对误差是否在桶宽度内(2^-SUB_BITS)
+ */
+static bool Near(uint64_t value, uint64_t expect)
+{
+    return fabs((double)value - (double)expect) <= expect / 32.0 + 1;
+}
+
+// --------------------------------------------------------------------------------
+//                                Histogram
+// --------------------------------------------------------------------------------
+
+static void Histogram_test()
+{
+    // 空
+    {
+        Tools::Histogram hist;
+        auto             rs = hist.Snapshot();
+        CHECK_EQ(rs.count, 0);
+        CHECK_EQ(rs.min, 0);
+        CHECK_EQ(rs.max, 0);
+        CHECK_EQ(rs.p50, 0);
+        CHECK_EQ(hist.Percentile(100), 0);
+    }
+    // 小数值逐一成桶，结果精确
+    {
+        Tools::Histogram hist;
+        for (int i = 0; i < 20; i++)
+            hist.Record(i);
+        CHECK_EQ(hist.Percentile(0), 0);
+        CHECK_EQ(hist.Percentile(50), 9);
+        CHECK_EQ(hist.Percentile(100), 19);
+        auto rs = hist.Snapshot();
+        CHECK_EQ(rs.count, 20);
+        CHECK(rs.mean == 9.5);
+    }
+    // 均匀分布，误差不超过桶宽度
+    {
+        Tools::Histogram hist;
+        for (uint64_t i = 1; i <= 100000; i++)
+            hist.Record(i * 1000);
+        auto rs = hist.Snapshot();
+        CHECK_EQ(rs.count, 100000);
+        CHECK_EQ(rs.min, 1000);
+        CHECK_EQ(rs.max, 100000000);
+        CHECK(Near(rs.p50, 50000000));
+        CHECK(Near(rs.p90, 90000000));
+        CHECK(Near(rs.p99, 99000000));
+        CHECK(rs.p50 <= rs.p90 && rs.p90 <= rs.p99 && rs.p99 <= rs.max);
+        // 超出范围按边界处理
+        CHECK_EQ(hist.Percentile(-1), hist.Percentile(0));
+        CHECK_EQ(hist.Percentile(200), hist.Percentile(100));
+        CHECK(Near(hist.Percentile(100), rs.max));
+    }
+    // 极值不越界，结果限制在记录范围内
+    {
+        Tools::Histogram hist;
+        hist.Record(UINT64_MAX);
+        CHECK(hist.Percentile(50) == UINT64_MAX);
+        hist.Record(12345);
+        CHECK(Near(hist.Percentile(0), 12345));
+        CHECK(hist.Percentile(0) >= 12345);
+    }
+    // 重置
+    {
+        Tools::Histogram hist;
+        hist.Record(100);
+        hist.Reset();
+        auto rs = hist.Snapshot();
+        CHECK_EQ(rs.count, 0);
+        CHECK_EQ(rs.max, 0);
+        hist.Record(7);
+        CHECK_EQ(hist.Snapshot().min, 7);
+    }
+    // 并发记录不丢失
+    {
+        Tools::Histogram hist;
+        {
+            Tools::ThreadPool pool(4);
+            for (int t = 0; t < 4; t++) {
+                pool.Post([&hist, t] {
+                    for (uint64_t i = 0; i < 100000; i++)
+                        hist.Record(t * 100000 + i);
+                });
+            }
+        }
+        auto rs = hist.Snapshot();
+        CHECK_EQ(rs.count, 400000);
+        CHECK_EQ(rs.min, 0);
+        CHECK_EQ(rs.max, 399999);
+        CHECK(rs.mean == 199999.5);
+    }
+    return;
+}
+
+int main()
+{
+    Histogram_test();
+    return Test::Report("test_perf");
+}
@@ -0,0 +1,88 @@
+/**
+ * @file     test_tensor.cpp
+ * @brief    Tensor 测试
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "Tensor.hpp"
+#include <math.h>
+
+using namespace AIMethod;
+
+// --------------------------------------------------------------------------------
+//                                Float16
+// --------------------------------------------------------------------------------
+
+static void Float16_test()
+{
+    // 特殊值
+    CHECK(Float16::ToFloat(0x0000) == 0.0f && !signbit(Float16::ToFloat(0x0000)));
+    CHECK(Float16::ToFloat(0x8000) == 0.0f && signbit(Float16::ToFloat(0x8000)));
+    CHECK(Float16::ToFloat(0x3C00) == 1.0f);
+    CHECK(Float16::ToFloat(0xC000) == -2.0f);
+    CHECK(Float16::ToFloat(0x7BFF) == 65504.0f);
+    CHECK(Float16::ToFloat(0x0001) == ldexpf(1, -24));   // 最小非规格化数
+    CHECK(Float16::ToFloat(0x0400) == ldexpf(1, -14));   // 最小规格化数
+    CHECK(isinf(Float16::ToFloat(0x7C00)) && Float16::ToFloat(0x7C00) > 0);
+    CHECK(isinf(Float16::ToFloat(0xFC00)) && Float16::ToFloat(0xFC00) < 0);
+    CHECK(isnan(Float16::ToFloat(0x7E00)));
+    CHECK_EQ(Float16::FromFloat(INFINITY), 0x7C00);
+    CHECK_EQ(Float16::FromFloat(-INFINITY), 0xFC00);
+    CHECK(isnan(Float16::ToFloat(Float16::FromFloat(NAN))));
+    CHECK_EQ(Float16::FromFloat(-0.0f), 0x8000);
+    // 溢出: 65520 是 65504 与下一个(不可表示)值的中点，向偶数舍入为无穷大
+    CHECK_EQ(Float16::FromFloat(65519.0f), 0x7BFF);
+    CHECK_EQ(Float16::FromFloat(65520.0f), 0x7C00);
+    CHECK_EQ(Float16::FromFloat(1e10f), 0x7C00);
+    // 下溢: 最小非规格化数一半以下为0，一半处向偶数舍入为0
+    CHECK_EQ(Float16::FromFloat(ldexpf(1, -25)), 0x0000);
+    CHECK_EQ(Float16::FromFloat(nextafterf(ldexpf(1, -25), 1)), 0x0001);
+    CHECK_EQ(Float16::FromFloat(1e-10f), 0x0000);
+
+    // 全部有限值往返不变
+    int mismatch = 0;
+    for (uint32_t h = 0; h < 0x10000; h++) {
+        if ((h & 0x7C00) == 0x7C00 && (h & 0x03FF) != 0)
+            continue;   // NaN
+        if (Float16::FromFloat(Float16::ToFloat((uint16_t)h)) != h)
+            mismatch++;
+    }
+    CHECK_EQ(mismatch, 0);
+
+    // 相邻两个值之间: 中点向偶数舍入，中点两侧就近舍入
+    mismatch = 0;
+    for (uint16_t h = 0; h < 0x7BFF; h++) {
+        float a    = Float16::ToFloat(h);
+        float b    = Float16::ToFloat(h + 1);
+        float mid  = (a + b) / 2;   // 半精度相邻值的中点在单精度中可精确表示
+        auto  even = (h & 1) == 0 ? h : (uint16_t)(h + 1);
+        if (Float16::FromFloat(mid) != even ||
+            Float16::FromFloat(nextafterf(mid, 0)) != h ||
+            Float16::FromFloat(nextafterf(mid, INFINITY)) != h + 1 ||
+            Float16::FromFloat(-mid) != (even | 0x8000))
+            mismatch++;
+    }
+    CHECK_EQ(mismatch, 0);
+
+    // 隐式转换
+    Float16 v = 0.5f;
+    CHECK_EQ(v.bits, 0x3800);
+    CHECK((float)v == 0.5f);
+    return;
+}
+
+int main()
+{
+    Float16_test();
+    return Test::Report("test_tensor");
+}
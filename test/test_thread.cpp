@@ -0,0 +1,352 @@
+/**
+ * @file     test_thread.cpp
+ * @brief    Tools.Thread 测试
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "Tools.Thread.hpp"
+#include <set>
+#include <memory>
+#include <future>
+
+// --------------------------------------------------------------------------------
+//                                ThreadPool
+// --------------------------------------------------------------------------------
+
+static void ThreadPool_test()
+{
+    // 线程数下限为 1
+    {
+        Tools::ThreadPool pool(0);
+        CHECK_EQ(pool.Size(), 1);
+    }
+    // 全部任务执行且分布在多个线程
+    {
+        std::atomic<int>          count(0);
+        std::mutex                mutex;
+        std::set<std::thread::id> ids;
+        {
+            Tools::ThreadPool pool(4);
+            CHECK_EQ(pool.Size(), 4);
+            for (int i = 0; i < 1000; i++) {
+                CHECK(pool.Post([&] {
+                    std::this_thread::sleep_for(std::chrono::microseconds(10));
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ids.insert(std::this_thread::get_id());
+                    count++;
+                }));
+            }
+        }
+        CHECK_EQ(count.load(), 1000);
+        CHECK(ids.size() > 1);
+        CHECK(ids.count(std::this_thread::get_id()) == 0);
+    }
+    // 析构时执行完已排队的任务
+    {
+        std::atomic<int> count(0);
+        {
+            Tools::ThreadPool pool(1);
+            pool.Post([] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+            for (int i = 0; i < 10; i++)
+                pool.Post([&] { count++; });
+        }
+        CHECK_EQ(count.load(), 10);
+    }
+    // 任务中可以继续提交任务
+    {
+        std::atomic<int> count(0);
+        {
+            Tools::ThreadPool pool(2);
+            pool.Post([&] {
+                count++;
+                pool.Post([&] { count++; });
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        CHECK_EQ(count.load(), 2);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                BlockingQueue
+// --------------------------------------------------------------------------------
+
+static void BlockingQueue_test()
+{
+    // 先进先出，容量下限为 1
+    {
+        Tools::BlockingQueue<int> queue(0);
+        int                       v = -1;
+        CHECK(queue.Push(1));
+        CHECK_EQ(queue.Size(), 1);
+        CHECK(queue.Pop(v));
+        CHECK_EQ(v, 1);
+    }
+    // 满时阻塞生产者
+    {
+        Tools::BlockingQueue<int> queue(2);
+        std::atomic<bool>         pushed(false);
+        queue.Push(1);
+        queue.Push(2);
+        std::thread thr([&] {
+            queue.Push(3);
+            pushed = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(!pushed);
+        int v = 0;
+        CHECK(queue.Pop(v));
+        CHECK_EQ(v, 1);
+        thr.join();
+        CHECK(pushed);
+        CHECK(queue.Pop(v));
+        CHECK_EQ(v, 2);
+        CHECK(queue.Pop(v));
+        CHECK_EQ(v, 3);
+    }
+    // 关闭后拒绝写入，剩余数据仍可读出，读空后返回失败
+    {
+        Tools::BlockingQueue<std::unique_ptr<int>> queue(4);
+        std::unique_ptr<int>                       v;
+        queue.Push(std::unique_ptr<int>(new int(5)));
+        queue.Close();
+        CHECK(!queue.Push(std::unique_ptr<int>(new int(6))));
+        CHECK(queue.Pop(v));
+        CHECK(v != nullptr && *v == 5);
+        CHECK(!queue.Pop(v));
+    }
+    // 关闭唤醒阻塞的消费者
+    {
+        Tools::BlockingQueue<int> queue(1);
+        std::atomic<int>          result(-1);
+        std::thread               thr([&] {
+            int v;
+            result = queue.Pop(v) ? 1 : 0;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Close();
+        thr.join();
+        CHECK_EQ(result.load(), 0);
+    }
+    // 多生产者多消费者不丢失不重复
+    {
+        Tools::BlockingQueue<int> queue(8);
+        std::vector<int>          seen(40000, 0);
+        std::vector<std::thread>  producers;
+        std::vector<std::thread>  consumers;
+        std::mutex                mutex;
+        for (int t = 0; t < 4; t++) {
+            producers.push_back(std::thread([&queue, t] {
+                for (int i = 0; i < 10000; i++)
+                    queue.Push(t * 10000 + i);
+            }));
+            consumers.push_back(std::thread([&] {
+                int v;
+                while (queue.Pop(v)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    seen[v]++;
+                }
+            }));
+        }
+        for (auto &thr : producers)
+            thr.join();
+        queue.Close();
+        for (auto &thr : consumers)
+            thr.join();
+        bool ok = true;
+        for (auto n : seen)
+            ok = ok && n == 1;
+        CHECK(ok);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                Timer
+// --------------------------------------------------------------------------------
+
+static void Timer_test()
+{
+    Tools::Timer timer;
+    // 按时间顺序执行
+    {
+        std::mutex         mutex;
+        std::vector<int>   order;
+        std::promise<void> promise;
+        auto               now = Tools::GetNanosecond();
+        timer.Add(now + 20000000, [&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(2);
+            promise.set_value();
+        });
+        timer.Add(now + 5000000, [&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(1);
+        });
+        promise.get_future().wait();
+        CHECK(Tools::GetNanosecond() >= now + 20000000);
+        CHECK(order.size() == 2 && order[0] == 1 && order[1] == 2);
+    }
+    // 删除未执行的任务
+    {
+        std::atomic<int> count(0);
+        auto             id = timer.Add(Tools::GetNanosecond() + 10000000, [&] { count++; });
+        timer.Remove(id);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK_EQ(count.load(), 0);
+    }
+    // 删除正在执行的任务时等待完成
+    {
+        std::atomic<int> state(0);
+        auto             id = timer.Add(0, [&] {
+            state = 1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            state = 2;
+        });
+        while (state == 0)
+            std::this_thread::yield();
+        timer.Remove(id);
+        CHECK_EQ(state.load(), 2);
+    }
+    // 在任务中删除自身不等待
+    {
+        std::promise<void>    promise;
+        std::atomic<uint64_t> id(0);
+        id = timer.Add(Tools::GetNanosecond() + 5000000, [&] {
+            timer.Remove(id);
+            promise.set_value();
+        });
+        CHECK(promise.get_future().wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                LockFreeQueue
+// --------------------------------------------------------------------------------
+
+static void LockFreeQueue_test()
+{
+    // 容量按2的幂向上取整，满时写入失败
+    {
+        Tools::LockFreeQueue<int> queue(3);
+        int                       v;
+        for (int i = 0; i < 4; i++) {
+            v = i;
+            CHECK(queue.TryPush(v));
+        }
+        v = 4;
+        CHECK(!queue.TryPush(v));
+        for (int i = 0; i < 4; i++) {
+            CHECK(queue.TryPop(v));
+            CHECK_EQ(v, i);
+        }
+        CHECK(!queue.TryPop(v));
+    }
+    // 取出后释放槽位中的对象
+    {
+        auto                                       ptr = std::make_shared<int>(1);
+        Tools::LockFreeQueue<std::shared_ptr<int>> queue(2);
+        auto                                       tmp = ptr;
+        queue.TryPush(tmp);
+        CHECK(tmp == nullptr);
+        CHECK_EQ(ptr.use_count(), 2);
+        queue.TryPop(tmp);
+        tmp = nullptr;
+        CHECK_EQ(ptr.use_count(), 1);
+    }
+    // 多生产者多消费者不丢失不重复
+    {
+        const int                     count = 100000;
+        Tools::LockFreeQueue<int>     queue(64);
+        std::vector<std::atomic<int>> seen(count * 4);
+        std::atomic<int>              popped(0);
+        std::vector<std::thread>      threads;
+        for (auto &n : seen)
+            n.store(0);
+        for (int t = 0; t < 4; t++) {
+            threads.push_back(std::thread([&queue, t] {
+                for (int i = 0; i < count; i++) {
+                    int v = t * count + i;
+                    while (!queue.TryPush(v))
+                        std::this_thread::yield();
+                }
+            }));
+            threads.push_back(std::thread([&] {
+                int v;
+                while (popped.load() < count * 4) {
+                    if (queue.TryPop(v)) {
+                        seen[v]++;
+                        popped++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            }));
+        }
+        for (auto &thr : threads)
+            thr.join();
+        bool ok = true;
+        for (auto &n : seen)
+            ok = ok && n.load() == 1;
+        CHECK(ok);
+    }
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                CompletionExecutor
+// --------------------------------------------------------------------------------
+
+static void CompletionExecutor_test()
+{
+    // 无线程时由调用者执行，队列满时提交失败
+    {
+        std::atomic<int>          notified(0);
+        std::atomic<int>          count(0);
+        Tools::CompletionExecutor executor(0, 4, [&] { notified++; });
+        for (int i = 0; i < 4; i++)
+            CHECK(executor.Post([&] { count++; }));
+        CHECK(!executor.Post([&] { count++; }));
+        CHECK_EQ(notified.load(), 4);
+        CHECK_EQ(executor.Pending(), 4);
+        CHECK_EQ(executor.Poll(3), 3);
+        CHECK_EQ(count.load(), 3);
+        CHECK_EQ(executor.Poll(), 1);
+        CHECK_EQ(executor.Pending(), 0);
+    }
+    // 工作线程执行全部任务，销毁时执行剩余任务
+    {
+        std::atomic<int> count(0);
+        {
+            Tools::CompletionExecutor executor(2);
+            for (int i = 0; i < 10000; i++) {
+                while (!executor.Post([&] { count++; }))
+                    std::this_thread::yield();
+            }
+        }
+        CHECK_EQ(count.load(), 10000);
+    }
+    return;
+}
+
+int main()
+{
+    ThreadPool_test();
+    BlockingQueue_test();
+    LockFreeQueue_test();
+    CompletionExecutor_test();
+    Timer_test();
+    return Test::Report("test_thread");
+}
@@ -0,0 +1,84 @@
+/**
+ * @file     test_tools.cpp
+ * @brief    Tools 测试
+ * @author   CXS (chenxiangshu@outlook.com)
+ * @version  1.0
+ * @date     2026-10-18
+ *
+ * @copyright Copyright (c) 2024  Four-Faith
+ *
+ * @par 修改日志:
+ * <table>
+ * <tr><th>日期       <th>版本    <th>作者    <th>说明
+ * <tr><td>2026-10-18 <td>1.0     <td>CXS     <td>创建
+ * </table>
+ */
+#include "Test.hpp"
+#include "Tools.hpp"
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/**
+ * @brief    创建空文件
+ */
+static void Touch(const std::string &path)
+{
+    FILE *fp = fopen(path.c_str(), "w");
+    if (fp != nullptr)
+        fclose(fp);
+    return;
+}
+
+// --------------------------------------------------------------------------------
+//                                GetFiles
+// --------------------------------------------------------------------------------
+
+static void GetFiles_test()
+{
+    char tmp[] = "/tmp/test_tools.XXXXXX";
+    CHECK(mkdtemp(tmp) != nullptr);
+    std::string root = tmp;
+    // root/{a.jpg, b.txt, link.jpg -> a.jpg, sub/{c.jpg, loop -> root}, 隐藏文件 .hidden.jpg, ._x.jpg, .git/d.jpg}
+    mkdir((root + "/sub").c_str(), 0755);
+    mkdir((root + "/.git").c_str(), 0755);
+    Touch(root + "/a.jpg");
+    Touch(root + "/.hidden.jpg");
+    Touch(root + "/._x.jpg");
+    Touch(root + "/.git/d.jpg");
+    Touch(root + "/b.txt");
+    Touch(root + "/sub/c.jpg");
+    CHECK(symlink("a.jpg", (root + "/link.jpg").c_str()) == 0);
+    CHECK(symlink("..", (root + "/sub/loop").c_str()) == 0);
+
+    auto top = Tools::GetFiles(root, "jpg");
+    CHECK(top == strings({"a.jpg", "link.jpg"}));
+    auto all = Tools::GetFiles(root, std::string());
+    CHECK(all == strings({"a.jpg", "b.txt", "link.jpg"}));
+    // 指向上级目录的链接不会重复遍历，隐藏目录不遍历
+    auto rec = Tools::GetFiles(root, "jpg", true);
+    CHECK(rec == strings({"a.jpg", "link.jpg", "sub/c.jpg"}));
+    // 从子目录开始时，链接指向的上级目录只遍历一次
+    auto sub = Tools::GetFiles(root + "/sub", "jpg", true);
+    CHECK(sub == strings({"c.jpg", "loop/a.jpg", "loop/link.jpg"}));
+    CHECK(Tools::GetFiles(root + "/none", "jpg", true).empty());
+
+    unlink((root + "/sub/loop").c_str());
+    unlink((root + "/sub/c.jpg").c_str());
+    rmdir((root + "/sub").c_str());
+    unlink((root + "/link.jpg").c_str());
+    unlink((root + "/b.txt").c_str());
+    unlink((root + "/a.jpg").c_str());
+    unlink((root + "/.hidden.jpg").c_str());
+    unlink((root + "/._x.jpg").c_str());
+    unlink((root + "/.git/d.jpg").c_str());
+    rmdir((root + "/.git").c_str());
+    rmdir(root.c_str());
+    return;
+}
+
+int main()
+{
+    GetFiles_test();
+    return Test::Report("test_tools");
+}